@@ -0,0 +1,28 @@
+#include "ByteStickerStorage.h"
+
+#include <cstring>
+
+ByteStickerStorage::ByteStickerStorage(unsigned int numStickersEdge)
+	: m_stickers(numStickersEdge),
+	m_moveTable(MoveTable::ForCubeLevel(numStickersEdge))
+{
+}
+
+void ByteStickerStorage::Read(uint8_t* stickers) const
+{
+	if (m_stickers.IsCanonical()) {
+		std::memcpy(stickers, m_stickers.Data(), m_stickers.Size());
+		return;
+	}
+
+	// Lazily turned faces are materialized straight into the output
+	for (auto face = 0u; face < StickerBuffer::NUM_FACES; face++) {
+		m_stickers.CopyFace(face, stickers + face * m_stickers.FaceStride());
+	}
+}
+
+void ByteStickerStorage::Write(const uint8_t* stickers)
+{
+	m_stickers.ResetFaceTurns();
+	std::memcpy(m_stickers.Data(), stickers, m_stickers.Size());
+}
\ No newline at end of file
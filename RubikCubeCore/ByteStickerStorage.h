@@ -0,0 +1,34 @@
+#ifndef BYTE_STICKER_STORAGE_H
+#define BYTE_STICKER_STORAGE_H
+
+#include "StickerStorage.h"
+#include "StickerBuffer.h"
+#include "MoveTable.h"
+
+#include <memory>
+
+// One byte per sticker, moves are performed by the shared move table of the cube's level
+class ByteStickerStorage final : public StickerStorage {
+private:
+
+	StickerBuffer m_stickers;
+	std::shared_ptr<const MoveTable> m_moveTable;
+
+public:
+
+	explicit ByteStickerStorage(unsigned int numStickersEdge);
+
+	unsigned int NumStickersEdge() const override { return m_stickers.NumStickersEdge(); }
+	std::unique_ptr<StickerStorage> Clone() const override { return std::make_unique<ByteStickerStorage>(*this); }
+
+	uint8_t Get(unsigned int face, unsigned int x, unsigned int y) const override { return m_stickers.At(face, x, y); }
+	void FillFace(unsigned int face, uint8_t color) override { m_stickers.FillFace(face, color); }
+
+	void Rotate(MoveTable::Axis axis, unsigned int layer, bool clockwise) override
+		{ m_moveTable->Apply(m_stickers, axis, layer, clockwise); }
+
+	void Read(uint8_t* stickers) const override;
+	void Write(const uint8_t* stickers) override;
+};
+
+#endif
\ No newline at end of file
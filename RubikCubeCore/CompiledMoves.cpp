@@ -0,0 +1,137 @@
+#include "CompiledMoves.h"
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+CompiledMoves::CompiledMoves(unsigned int numStickersEdge, const std::vector<MoveTable::Move>& moves)
+	: m_numStickersEdge(numStickersEdge),
+	m_numMoves(moves.size())
+{
+	auto n = numStickersEdge;
+	auto faceStride = static_cast<size_t>(n) * n;
+	auto last = n - 1;
+
+	// Every sticker is labeled by its own index, moves shift labels instead of colors
+	std::vector<MoveTable::StickerIndex> labels(StickerBuffer::NUM_FACES * faceStride);
+	unsigned int faceTurns[StickerBuffer::NUM_FACES] = {};
+
+	for (size_t i = 0; i < labels.size(); i++) {
+		labels[i] = static_cast<MoveTable::StickerIndex>(i);
+	}
+
+	auto index = [&](unsigned int face, unsigned int x, unsigned int y) {
+		StickerBuffer::ResolveFaceTurns(faceTurns[face], last, x, y);
+		return face * faceStride + x * n + y;
+	};
+
+	for (auto& m : moves) {
+		if (m.axis >= MoveTable::NUM_AXES || m.layer >= n) {
+			throw std::runtime_error("CompiledMoves: move does not fit the cube's level");
+		}
+		auto move = MoveTable::Describe(n, m.axis, m.layer, m.clockwise);
+
+		// Same ring shift as MoveTable performs on big cubes
+		MoveTable::StickerIndex* line[4];
+		ptrdiff_t stride[4];
+
+		for (auto j = 0u; j < 4u; j++) {
+			auto& l = move.ring[j];
+			auto start = index(l.face, l.x, l.y);
+			auto next = index(l.face, l.x + l.dx, l.y + l.dy);
+
+			line[j] = labels.data() + start;
+			stride[j] = static_cast<ptrdiff_t>(next) - static_cast<ptrdiff_t>(start);
+		}
+
+		for (auto k = 0u; k < n; k++) {
+			auto tmp = *line[0];
+			*line[0] = *line[1];
+			*line[1] = *line[2];
+			*line[2] = *line[3];
+			*line[3] = tmp;
+
+			line[0] += stride[0];
+			line[1] += stride[1];
+			line[2] += stride[2];
+			line[3] += stride[3];
+		}
+
+		if (move.turnsFace) {
+			faceTurns[move.face] = (faceTurns[move.face] + (move.faceClockwise ? 1u : 3u)) & 3u;
+		}
+	}
+
+	// Materialize turned faces, so the permutation is in the layout with no face turned
+	m_source.resize(labels.size());
+
+	for (auto face = 0u; face < StickerBuffer::NUM_FACES; face++) {
+		for (auto x = 0u; x < n; x++) {
+			for (auto y = 0u; y < n; y++) {
+				m_source[face * faceStride + x * n + y] = labels[index(face, x, y)];
+			}
+		}
+	}
+}
+
+std::shared_ptr<const CompiledMoves> CompiledMoves::Compile(unsigned int numStickersEdge,
+	const std::vector<MoveTable::Move>& moves)
+{
+	if (numStickersEdge == 0) {
+		throw std::runtime_error("CompiledMoves: number of stickers per edge cannot be zero");
+	}
+	return std::shared_ptr<const CompiledMoves>(new CompiledMoves(numStickersEdge, moves));
+}
+
+std::shared_ptr<const CompiledMoves> CompiledMoves::ForSequence(unsigned int numStickersEdge,
+	const std::vector<MoveTable::Move>& moves)
+{
+	// Sequences are told apart by two independent 64 bit hashes and their length, nothing is copied
+	uint64_t first = 14695981039346656037ull;
+	uint64_t second = 0;
+
+	for (auto& m : moves) {
+		auto word = (static_cast<uint64_t>(m.layer) << 3) | (static_cast<uint64_t>(m.axis) << 1) | (m.clockwise ? 1u : 0u);
+		first = (first ^ word) * 1099511628211ull;
+		second = (second ^ word) * 0x9E3779B97F4A7C15ull;
+		second ^= second >> 29;
+	}
+
+	typedef std::tuple<unsigned int, size_t, uint64_t, uint64_t> Key;
+	static std::mutex cacheMutex;
+	static std::map<Key, std::weak_ptr<const CompiledMoves>> cache;
+	static size_t sweepSize = 16u;
+
+	std::lock_guard<std::mutex> lock(cacheMutex);
+
+	// An entry nobody holds anymore is compiled again on its next lookup
+	auto& cached = cache[Key(numStickersEdge, moves.size(), first, second)];
+	auto compiled = cached.lock();
+
+	if (!compiled) {
+		compiled = Compile(numStickersEdge, moves);
+		cached = compiled;
+
+		// Entries never looked up again are forgotten once the cache doubles, so sweeping is amortized
+		if (cache.size() >= sweepSize) {
+			for (auto it = cache.begin(); it != cache.end();) {
+				it = it->second.expired() ? cache.erase(it) : std::next(it);
+			}
+			sweepSize = std::max<size_t>(16u, 2u * cache.size());
+		}
+	}
+	return compiled;
+}
+
+void CompiledMoves::Apply(const uint8_t* source, uint8_t* destination) const
+{
+	auto indices = m_source.data();
+	auto numStickers = m_source.size();
+
+	for (size_t i = 0; i < numStickers; i++) {
+		destination[i] = source[indices[i]];
+	}
+}
\ No newline at end of file
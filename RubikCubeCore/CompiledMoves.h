@@ -0,0 +1,49 @@
+#ifndef COMPILED_MOVES_H
+#define COMPILED_MOVES_H
+
+#include "MoveTable.h"
+
+#include <memory>
+#include <vector>
+#include <cstdint>
+
+// Move sequence folded into a single sticker permutation for one cube's level
+// Compiling shifts sticker indices instead of colors through the same lazily turned faces
+// as StickerBuffer, so it takes O(N) per move plus O(N^2) once at the end
+// Applying the permutation is one gather over all stickers, no matter how long the sequence was
+class CompiledMoves final {
+private:
+
+	unsigned int m_numStickersEdge;
+	size_t m_numMoves;
+
+	// Sticker i of the result is taken from sticker m_source[i], StickerBuffer layout with no face turned
+	std::vector<MoveTable::StickerIndex> m_source;
+
+	CompiledMoves(unsigned int numStickersEdge, const std::vector<MoveTable::Move>& moves);
+
+public:
+
+	CompiledMoves(const CompiledMoves&) = delete;
+	CompiledMoves& operator=(const CompiledMoves&) = delete;
+
+	// Fold the sequence, throws an exception if some move does not fit the cube's level
+	static std::shared_ptr<const CompiledMoves> Compile(unsigned int numStickersEdge,
+		const std::vector<MoveTable::Move>& moves);
+
+	// Same as Compile(), but the permutation is shared by all cubes of the same level
+	// as long as somebody holds it, the cache keeps only hashes of sequences
+	static std::shared_ptr<const CompiledMoves> ForSequence(unsigned int numStickersEdge,
+		const std::vector<MoveTable::Move>& moves);
+
+	unsigned int NumStickersEdge() const { return m_numStickersEdge; }
+	size_t NumMoves() const { return m_numMoves; }
+	size_t NumStickers() const { return m_source.size(); }
+
+	const MoveTable::StickerIndex* Source() const { return m_source.data(); }
+
+	// Gather NumStickers() stickers from source into destination, buffers must not overlap
+	void Apply(const uint8_t* source, uint8_t* destination) const;
+};
+
+#endif
\ No newline at end of file
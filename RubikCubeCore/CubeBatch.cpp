@@ -0,0 +1,172 @@
+#include "CubeBatch.h"
+#include "WorkerPool.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <cstring>
+
+// Taken by reference in std::min
+constexpr size_t CubeBatch::BLOCK_SIZE;
+
+CubeBatch::CubeBatch(unsigned int numStickersEdge, size_t numCubes, const uint8_t* faceColors)
+	: m_numStickersEdge(numStickersEdge),
+	m_numCubes(numCubes)
+{
+	if (numStickersEdge == 0 || numCubes == 0) {
+		throw std::runtime_error("CubeBatch: number of stickers per edge and number of cubes cannot be zero");
+	}
+
+	// Every row starts on its own cache line
+	m_rowStride = (numCubes + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+	m_memory.reset(new uint8_t[NumStickers() * m_rowStride + ALIGNMENT]);
+
+	auto address = reinterpret_cast<uintptr_t>(m_memory.get());
+	m_data = m_memory.get() + (ALIGNMENT - address % ALIGNMENT) % ALIGNMENT;
+
+	std::memset(m_faceTurns, 0, sizeof(m_faceTurns));
+
+	auto faceStride = static_cast<size_t>(numStickersEdge) * numStickersEdge;
+
+	for (auto face = 0u; face < StickerBuffer::NUM_FACES; face++) {
+		std::memset(Row(face * faceStride), faceColors[face], faceStride * m_rowStride);
+	}
+}
+
+void CubeBatch::Canonicalize()
+{
+	auto n = m_numStickersEdge;
+	auto faceStride = static_cast<size_t>(n) * n;
+	std::unique_ptr<uint8_t[]> face;
+
+	for (auto f = 0u; f < StickerBuffer::NUM_FACES; f++) {
+		if (m_faceTurns[f] == 0) {
+			continue;
+		}
+		if (!face) {
+			face.reset(new uint8_t[faceStride * m_rowStride]);
+		}
+
+		for (auto x = 0u; x < n; x++) {
+			for (auto y = 0u; y < n; y++) {
+				std::memcpy(face.get() + (x * n + y) * m_rowStride, Row(Index(f, x, y)), m_rowStride);
+			}
+		}
+		std::memcpy(Row(f * faceStride), face.get(), faceStride * m_rowStride);
+		m_faceTurns[f] = 0;
+	}
+}
+
+void CubeBatch::ReadCube(size_t cube, uint8_t* stickers) const
+{
+	auto n = m_numStickersEdge;
+
+	for (auto face = 0u; face < StickerBuffer::NUM_FACES; face++) {
+		for (auto x = 0u; x < n; x++) {
+			for (auto y = 0u; y < n; y++) {
+				*stickers++ = Row(Index(face, x, y))[cube];
+			}
+		}
+	}
+}
+
+void CubeBatch::WriteCube(size_t cube, const uint8_t* stickers)
+{
+	auto n = m_numStickersEdge;
+
+	for (auto face = 0u; face < StickerBuffer::NUM_FACES; face++) {
+		for (auto x = 0u; x < n; x++) {
+			for (auto y = 0u; y < n; y++) {
+				Row(Index(face, x, y))[cube] = *stickers++;
+			}
+		}
+	}
+}
+
+void CubeBatch::Rotate(MoveTable::Axis axis, unsigned int layer, bool clockwise)
+{
+	if (layer >= m_numStickersEdge) {
+		throw std::runtime_error("CubeBatch: rotation index is larger than number of stickers");
+	}
+
+	auto move = MoveTable::Describe(m_numStickersEdge, axis, layer, clockwise);
+	size_t sticker[4];
+	ptrdiff_t stride[4];
+
+	for (auto j = 0u; j < 4u; j++) {
+		auto& l = move.ring[j];
+		sticker[j] = Index(l.face, l.x, l.y);
+		stride[j] = static_cast<ptrdiff_t>(Index(l.face, l.x + l.dx, l.y + l.dy)) - static_cast<ptrdiff_t>(sticker[j]);
+	}
+
+	// One task shifts one column block of all rows of the ring, blocks of different tasks do not overlap
+	auto shiftBlock = [&](size_t blockIndex) {
+		uint8_t block[BLOCK_SIZE];
+		auto offset = blockIndex * BLOCK_SIZE;
+		auto size = std::min(BLOCK_SIZE, m_rowStride - offset);
+		size_t row[4] = { sticker[0], sticker[1], sticker[2], sticker[3] };
+
+		for (auto k = 0u; k < m_numStickersEdge; k++) {
+			uint8_t* rows[4] = { Row(row[0]) + offset, Row(row[1]) + offset, Row(row[2]) + offset, Row(row[3]) + offset };
+
+			std::memcpy(block, rows[0], size);
+			std::memcpy(rows[0], rows[1], size);
+			std::memcpy(rows[1], rows[2], size);
+			std::memcpy(rows[2], rows[3], size);
+			std::memcpy(rows[3], block, size);
+
+			for (auto j = 0u; j < 4u; j++) {
+				row[j] += stride[j];
+			}
+		}
+	};
+
+	auto numBlocks = (m_rowStride + BLOCK_SIZE - 1) / BLOCK_SIZE;
+
+	if (m_rowStride >= MIN_PARALLEL_ROW_SIZE) {
+		WorkerPool::Shared().Run(numBlocks, shiftBlock);
+	}
+	else {
+		for (size_t b = 0; b < numBlocks; b++) {
+			shiftBlock(b);
+		}
+	}
+
+	if (move.turnsFace) {
+		m_faceTurns[move.face] = (m_faceTurns[move.face] + (move.faceClockwise ? 1u : 3u)) & 3u;
+	}
+}
+
+void CubeBatch::ApplyCompiledMoves(const CompiledMoves& moves)
+{
+	if (moves.NumStickersEdge() != m_numStickersEdge) {
+		throw std::runtime_error("CubeBatch: compiled moves do not fit the cube's level");
+	}
+	Canonicalize();
+
+	std::unique_ptr<uint8_t[]> memory(new uint8_t[NumStickers() * m_rowStride + ALIGNMENT]);
+	auto address = reinterpret_cast<uintptr_t>(memory.get());
+	auto data = memory.get() + (ALIGNMENT - address % ALIGNMENT) % ALIGNMENT;
+	auto source = moves.Source();
+
+	auto gatherRows = [&](size_t begin, size_t end) {
+		for (auto i = begin; i < end; i++) {
+			std::memcpy(data + i * m_rowStride, Row(source[i]), m_rowStride);
+		}
+	};
+
+	if (m_rowStride >= MIN_PARALLEL_ROW_SIZE) {
+		auto& pool = WorkerPool::Shared();
+		auto numTasks = static_cast<size_t>(pool.NumThreads());
+		auto numStickers = NumStickers();
+
+		pool.Run(numTasks, [&](size_t task) {
+			gatherRows(numStickers * task / numTasks, numStickers * (task + 1) / numTasks);
+		});
+	}
+	else {
+		gatherRows(0, NumStickers());
+	}
+
+	m_memory = std::move(memory);
+	m_data = data;
+}
\ No newline at end of file
@@ -0,0 +1,76 @@
+#ifndef CUBE_BATCH_H
+#define CUBE_BATCH_H
+
+#include "CompiledMoves.h"
+#include "MoveTable.h"
+#include "StickerBuffer.h"
+
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+
+// Many cubes of the same level in structure-of-arrays layout: sticker i of all cubes is one contiguous row
+// The same move is applied to all cubes at once, the ring of a move is 4N rows shifted with block copies,
+// so moves run at memory bandwidth
+// All cubes share face orientation tags, outer faces are turned lazily just like in StickerBuffer
+class CubeBatch final {
+public:
+
+	static constexpr size_t ALIGNMENT = StickerBuffer::ALIGNMENT;
+
+private:
+
+	// Rows are shifted in blocks which stay in L1 cache
+	static constexpr size_t BLOCK_SIZE = 4096u;
+
+	// Moves on batches with shorter rows are not split between workers, syncing would cost more than the copies
+	static constexpr size_t MIN_PARALLEL_ROW_SIZE = 4u * BLOCK_SIZE;
+
+	std::unique_ptr<uint8_t[]> m_memory;
+	uint8_t* m_data;
+	unsigned int m_numStickersEdge;
+	size_t m_numCubes;
+	size_t m_rowStride;
+	uint8_t m_faceTurns[StickerBuffer::NUM_FACES];
+
+	size_t NumStickers() const { return StickerBuffer::NUM_FACES * static_cast<size_t>(m_numStickersEdge) * m_numStickersEdge; }
+
+	// Index of the sticker on position [x, y] of the face as it is seen on the cube
+	size_t Index(unsigned int face, unsigned int x, unsigned int y) const
+	{
+		StickerBuffer::ResolveFaceTurns(m_faceTurns[face], m_numStickersEdge - 1, x, y);
+		return (face * m_numStickersEdge + x) * static_cast<size_t>(m_numStickersEdge) + y;
+	}
+
+	uint8_t* Row(size_t sticker) { return m_data + sticker * m_rowStride; }
+	const uint8_t* Row(size_t sticker) const { return m_data + sticker * m_rowStride; }
+
+	// Physically rotate all turned faces of all cubes
+	void Canonicalize();
+
+public:
+
+	// All cubes are solved with given face colors
+	CubeBatch(unsigned int numStickersEdge, size_t numCubes, const uint8_t* faceColors);
+
+	CubeBatch(const CubeBatch&) = delete;
+	CubeBatch& operator=(const CubeBatch&) = delete;
+
+	unsigned int NumStickersEdge() const { return m_numStickersEdge; }
+	size_t NumCubes() const { return m_numCubes; }
+
+	uint8_t Get(size_t cube, unsigned int face, unsigned int x, unsigned int y) const { return Row(Index(face, x, y))[cube]; }
+
+	// Stickers of one cube in the StickerBuffer layout (face by face, row by row as seen on the cube)
+	void ReadCube(size_t cube, uint8_t* stickers) const;
+	void WriteCube(size_t cube, const uint8_t* stickers);
+
+	// Perform the move on all cubes
+	void Rotate(MoveTable::Axis axis, unsigned int layer, bool clockwise);
+
+	// Perform the compiled sequence on all cubes, one row copy per sticker
+	// Throws an exception if the sequence was compiled for another cube's level
+	void ApplyCompiledMoves(const CompiledMoves& moves);
+};
+
+#endif
\ No newline at end of file
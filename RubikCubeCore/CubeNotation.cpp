@@ -0,0 +1,238 @@
+#include "CubeNotation.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+bool IsDigit(char c) { return c >= '0' && c <= '9'; }
+bool IsSpace(char c) { return c == ' ' || c == '\n' || c == '\r' || c == '\t'; }
+
+// Digits are accumulated only while they fit the cube's level, bigger values are clamped to numStickersEdge + 1
+unsigned int ParseNumber(const char*& p, const char* end, unsigned int numStickersEdge)
+{
+	uint64_t number = 0;
+
+	for (; p != end && IsDigit(*p); p++) {
+		number = std::min<uint64_t>(number * 10u + static_cast<unsigned int>(*p - '0'), numStickersEdge + 1ull);
+	}
+	return static_cast<unsigned int>(number);
+}
+
+}
+
+const std::array<CubeNotation::Letter, 256> CubeNotation::LETTERS = []() {
+	std::array<Letter, 256> letters;
+	letters.fill({ MoveTable::X_AXIS, UNKNOWN_LETTER, false, true });
+
+	// MoveTable turns clockwise as seen from the first layer of the axis
+	letters['R'] = { MoveTable::X_AXIS, OUTER_LAYER, true, false }; // right
+	letters['L'] = { MoveTable::X_AXIS, OUTER_LAYER, false, true }; // left
+	letters['U'] = { MoveTable::Y_AXIS, OUTER_LAYER, true, false }; // up
+	letters['D'] = { MoveTable::Y_AXIS, OUTER_LAYER, false, true }; // down
+	letters['F'] = { MoveTable::Z_AXIS, OUTER_LAYER, true, false }; // front
+	letters['B'] = { MoveTable::Z_AXIS, OUTER_LAYER, false, true }; // back
+
+	for (auto face : { 'R', 'L', 'U', 'D', 'F', 'B' }) {
+		letters[face - 'A' + 'a'] = letters[face];
+		letters[face - 'A' + 'a'].kind = WIDE_LAYERS;
+	}
+
+	letters['M'] = { MoveTable::X_AXIS, MIDDLE_LAYERS, false, true }; // as L
+	letters['E'] = { MoveTable::Y_AXIS, MIDDLE_LAYERS, false, true }; // as D
+	letters['S'] = { MoveTable::Z_AXIS, MIDDLE_LAYERS, true, false }; // as F
+	letters['x'] = { MoveTable::X_AXIS, ALL_LAYERS, true, false }; // as R
+	letters['y'] = { MoveTable::Y_AXIS, ALL_LAYERS, true, false }; // as U
+	letters['z'] = { MoveTable::Z_AXIS, ALL_LAYERS, true, false }; // as F
+	letters['X'] = { MoveTable::X_AXIS, INDEXED_LAYER, false, true };
+	letters['Y'] = { MoveTable::Y_AXIS, INDEXED_LAYER, false, true };
+	letters['Z'] = { MoveTable::Z_AXIS, INDEXED_LAYER, false, true };
+	return letters;
+}();
+
+void CubeNotation::ParseToken(const char* begin, const char* end, unsigned int numStickersEdge, std::vector<MoveTable::Move>& moves)
+{
+	auto n = numStickersEdge;
+	auto p = begin;
+
+	// Optional layer prefix: 3Rw, 2-4r
+	unsigned int firstDepth = 0;
+	unsigned int lastDepth = 0;
+	bool hasPrefix = p != end && IsDigit(*p);
+	bool hasRange = false;
+
+	if (hasPrefix) {
+		firstDepth = lastDepth = ParseNumber(p, end, n);
+
+		if (p != end && *p == '-') {
+			p++;
+
+			if (p == end || !IsDigit(*p)) {
+				throw std::runtime_error("Missing end of layer range");
+			}
+			lastDepth = ParseNumber(p, end, n);
+			hasRange = true;
+		}
+	}
+
+	if (p == end) {
+		throw std::runtime_error("Missing face");
+	}
+	auto letter = LETTERS[static_cast<unsigned char>(*p++)];
+
+	if (letter.kind == UNKNOWN_LETTER) {
+		throw std::runtime_error("Unknown face");
+	}
+	if (letter.kind == OUTER_LAYER && p != end && *p == 'w') {
+		letter.kind = WIDE_LAYERS;
+		p++;
+	}
+	if (hasPrefix && letter.kind != OUTER_LAYER && letter.kind != WIDE_LAYERS) {
+		throw std::runtime_error("Layers can be given for face turns only");
+	}
+
+	if (letter.kind == INDEXED_LAYER) {
+		bool clockwise = p == end || *p != '.';
+		p += clockwise ? 0 : 1;
+
+		if (p == end || !IsDigit(*p)) {
+			throw std::runtime_error("Missing rotation level");
+		}
+		auto layer = ParseNumber(p, end, n);
+
+		if (p != end) {
+			throw std::runtime_error("Unexpected characters behind rotation level");
+		}
+		if (layer >= n) {
+			throw std::runtime_error("Rotation index is larger than number of stickers");
+		}
+		moves.push_back({ letter.axis, layer, clockwise == letter.clockwise });
+		return;
+	}
+
+	// Layers counted from the face from 1
+	switch (letter.kind) {
+	case OUTER_LAYER:
+		firstDepth = hasPrefix ? firstDepth : 1u;
+		lastDepth = hasPrefix ? lastDepth : 1u;
+		break;
+	case WIDE_LAYERS:
+		firstDepth = hasRange ? firstDepth : 1u;
+		lastDepth = hasPrefix ? lastDepth : 2u;
+		break;
+	case MIDDLE_LAYERS:
+		if (n < 3) {
+			throw std::runtime_error("Slice moves need at least 3 stickers per edge");
+		}
+		firstDepth = 2u;
+		lastDepth = n - 1u;
+		break;
+	default:
+		firstDepth = 1u;
+		lastDepth = n;
+		break;
+	}
+
+	// Suffix: nothing, ' or . (counter-clockwise), 2, 2' or 2. (half turn)
+	auto numTurns = 1u;
+	auto clockwise = true;
+
+	if (p != end && *p == '2') {
+		numTurns = 2u;
+		p++;
+	}
+	if (p != end && (*p == '\'' || *p == '.')) {
+		clockwise = false;
+		p++;
+	}
+	if (p != end) {
+		throw std::runtime_error("Unknown rotation suffix");
+	}
+	if (firstDepth == 0 || firstDepth > lastDepth) {
+		throw std::runtime_error("Invalid layer range");
+	}
+	if (lastDepth > n) {
+		throw std::runtime_error("Rotation index is larger than number of stickers");
+	}
+
+	for (auto turn = 0u; turn < numTurns; turn++) {
+		for (auto depth = firstDepth; depth <= lastDepth; depth++) {
+			auto layer = letter.fromLastLayer ? n - depth : depth - 1u;
+			moves.push_back({ letter.axis, layer, clockwise == letter.clockwise });
+		}
+	}
+}
+
+void CubeNotation::ParseSequence(const char* begin, const char* end, unsigned int numStickersEdge, std::vector<MoveTable::Move>& moves)
+{
+	for (auto p = begin; p != end;) {
+		if (IsSpace(*p)) {
+			p++;
+			continue;
+		}
+		auto tokenEnd = std::find_if(p, end, IsSpace);
+
+		try {
+			ParseToken(p, tokenEnd, numStickersEdge, moves);
+		}
+		catch (const std::exception& ex) {
+			throw std::runtime_error(std::string(p, tokenEnd) + ": " + ex.what());
+		}
+		p = tokenEnd;
+	}
+}
+
+void CubeNotation::ParseLegacyToken(const char* begin, const char* end, unsigned int numStickersEdge, std::vector<MoveTable::Move>& moves)
+{
+	auto n = numStickersEdge;
+	auto p = begin;
+
+	if (p == end) {
+		throw std::runtime_error("Missing face");
+	}
+	auto face = *p++;
+	bool clockwise = p == end || *p != '.';
+	p += clockwise ? 0 : 1;
+
+	unsigned int layer = 0;
+
+	switch (face) {
+	case 'L':
+	case 'D':
+	case 'B':
+		break;
+	case 'R':
+	case 'U':
+	case 'F':
+		layer = n - 1u;
+		break;
+	case 'M':
+	case 'E':
+	case 'S':
+		if (n != 3) {
+			throw std::runtime_error("This operator is for 3x3x3 Rubik's Cube only");
+		}
+		layer = 1u;
+		break;
+	case 'X':
+	case 'Y':
+	case 'Z':
+		if (p == end || !IsDigit(*p)) {
+			throw std::runtime_error("Missing rotation level");
+		}
+		layer = ParseNumber(p, end, n);
+
+		if (layer >= n) {
+			throw std::runtime_error("Rotation index is larger than number of stickers");
+		}
+		break;
+	default:
+		throw std::runtime_error("Unknown face");
+	}
+
+	if (p != end) {
+		throw std::runtime_error("Unknown rotation suffix");
+	}
+	moves.push_back({ LETTERS[static_cast<unsigned char>(face)].axis, layer, clockwise });
+}
\ No newline at end of file
@@ -0,0 +1,58 @@
+#ifndef CUBE_NOTATION_H
+#define CUBE_NOTATION_H
+
+#include "MoveTable.h"
+
+#include <array>
+#include <vector>
+#include <cstdint>
+
+// Standard cube notation for cubes of any level, one token expands into one or more moves:
+//   R L U D F B - outer layer clockwise as seen from the face
+//   R' or R. counter-clockwise, R2 (R2') half turn
+//   Rw or r - two outer layers, 3Rw or 3r - three outer layers, 3R - the third layer only,
+//   2-4Rw or 2-4r - layers 2 to 4 from the face
+//   M E S - all layers between the outer ones, turned as L, D and F
+//   x y z - the whole cube turned as R, U and F
+//   X12 Y12 Z12 - layer 12 counted from L, D and B (from 0), turned as L, D and B, X.12 counter-clockwise
+// Parsing allocates nothing, moves are appended to the caller's vector
+class CubeNotation final {
+public:
+
+	enum LetterKind : uint8_t {
+		UNKNOWN_LETTER,
+		OUTER_LAYER,
+		WIDE_LAYERS,
+		MIDDLE_LAYERS,
+		ALL_LAYERS,
+		INDEXED_LAYER
+	};
+
+	struct Letter {
+		MoveTable::Axis axis;
+		LetterKind kind;
+		// Layers are counted from the last layer of the axis
+		bool fromLastLayer;
+		// Direction of MoveTable::Move of the clockwise turn
+		bool clockwise;
+	};
+
+	// Meaning of all characters, UNKNOWN_LETTER for characters which do not start a move
+	static const std::array<Letter, 256> LETTERS;
+
+	CubeNotation() = delete;
+
+	// Append moves of one token with no spaces for the cube of given level
+	// Throws an exception if the token is invalid or does not fit the cube's level
+	static void ParseToken(const char* begin, const char* end, unsigned int numStickersEdge, std::vector<MoveTable::Move>& moves);
+
+	// Append moves of all tokens separated by spaces, throws an exception naming the invalid token
+	static void ParseSequence(const char* begin, const char* end, unsigned int numStickersEdge, std::vector<MoveTable::Move>& moves);
+
+	// Notation of older versions, kept for rotation logs saved by them: F B U D L R, M E S (3x3x3 only)
+	// and X12 Y12 Z12, each optionally followed by '.' (X.12) for counter-clockwise
+	// Every letter turns as seen from the first layer of its axis, so R U F and S turn opposite to ParseToken
+	static void ParseLegacyToken(const char* begin, const char* end, unsigned int numStickersEdge, std::vector<MoveTable::Move>& moves);
+};
+
+#endif
\ No newline at end of file
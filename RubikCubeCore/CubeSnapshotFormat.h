@@ -0,0 +1,46 @@
+#ifndef CUBE_SNAPSHOT_FORMAT_H
+#define CUBE_SNAPSHOT_FORMAT_H
+
+#include "LittleEndian.h"
+#include "ZobristHash.h"
+
+#include <cstdint>
+#include <cstddef>
+
+// Binary save file of the cube's stickers, all numbers are little endian:
+//   header: magic "RCSS", version (16 bits), layout (16 bits), cube's level (32 bits), reserved (32 bits),
+//   Zobrist hash of stickers (64 bits), checksum of the rest of the file (64 bits)
+//   face hashes: ZobristHash::FaceHashes (24 x 64 bits), the hash is restored from them without visiting stickers
+//   stickers: raw sticker buffer in the layout, it starts 8 byte aligned
+struct CubeSnapshotFormat {
+	// "RCSS" read as a little endian number
+	static constexpr uint32_t MAGIC = 0x53534352u;
+	static constexpr uint16_t VERSION = 1u;
+
+	// One byte per sticker face by face, row by row as seen on the cube, see StickerStorage::Read()
+	static constexpr uint16_t BYTE_LAYOUT = 0u;
+
+	static constexpr size_t HEADER_SIZE = 32u;
+	static constexpr size_t NUM_FACE_HASHES = StickerBuffer::NUM_FACES * 4u;
+	static constexpr size_t STICKERS_OFFSET = HEADER_SIZE + 8u * NUM_FACE_HASHES;
+
+	static constexpr uint64_t CHECKSUM_SEED = 14695981039346656037ull;
+
+	// FNV-1a over 64 bit words with the high half folded in, bytes behind the last word are added one by one
+	// Parts of the data can be added one after another while they are multiples of 8 bytes
+	static uint64_t UpdateChecksum(uint64_t checksum, const uint8_t* data, size_t size)
+	{
+		size_t i = 0;
+
+		for (; i + 8u <= size; i += 8u) {
+			checksum = (checksum ^ LittleEndian::Read(data + i, 8u)) * 1099511628211ull;
+			checksum ^= checksum >> 32;
+		}
+		for (; i < size; i++) {
+			checksum = (checksum ^ data[i]) * 1099511628211ull;
+		}
+		return checksum;
+	}
+};
+
+#endif
\ No newline at end of file
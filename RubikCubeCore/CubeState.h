@@ -0,0 +1,209 @@
+#ifndef CUBE_STATE_H
+#define CUBE_STATE_H
+
+#include "MoveTable.h"
+#include "ShuffleKernel.h"
+#include "StickerBuffer.h"
+
+#include <array>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <cstring>
+#include <cstdint>
+
+// Stickers of the cube with level N known at compile time
+// Same layout as StickerBuffer with no face turned, all move cycles are generated at compile time
+// and every move is expanded into a straight sequence of byte moves with constant indices
+// Moves picked at runtime on cubes up to 3x3x3 use the byte shuffle kernel instead,
+// an indirect call to the expanded move is slower than one shuffle
+template<unsigned int N>
+class CubeState final {
+public:
+
+	static_assert(N >= 2 && N <= MoveTable::MAX_CYCLE_TABLE_STICKERS_EDGE, "CubeState is meant for small cubes");
+
+	static constexpr unsigned int NUM_STICKERS = StickerBuffer::NUM_FACES * N * N;
+	static constexpr unsigned int NUM_MOVES = MoveTable::NUM_AXES * N * 2u;
+
+	// Stickers are padded to the whole shuffle block if they fit into it
+	static constexpr bool USES_SHUFFLE = NUM_STICKERS <= ShuffleKernel::NUM_BYTES;
+	static constexpr size_t STORAGE_SIZE = USES_SHUFFLE ? ShuffleKernel::NUM_BYTES : NUM_STICKERS;
+
+	static constexpr unsigned int MoveIndex(MoveTable::Axis axis, unsigned int layer, bool clockwise)
+		{ return (axis * N + layer) * 2u + (clockwise ? 1u : 0u); }
+
+private:
+
+	// Outer layer move shifts the ring and turns the face
+	static constexpr unsigned int MAX_CYCLES = N + (N * N) / 4u;
+
+	typedef uint16_t StickerIndex;
+
+	// Sticker colors are moved from stickers[i + 1] into stickers[i]
+	struct Cycle {
+		StickerIndex stickers[4];
+	};
+
+	struct Move {
+		unsigned int numCycles;
+		Cycle cycles[MAX_CYCLES];
+	};
+
+	struct MoveCycles {
+		Move moves[NUM_MOVES];
+	};
+
+	static constexpr StickerIndex Index(unsigned int face, unsigned int x, unsigned int y)
+		{ return static_cast<StickerIndex>((face * N + x) * N + y); }
+
+	static constexpr void AddCycle(Move& move, StickerIndex a, StickerIndex b, StickerIndex c, StickerIndex d)
+	{
+		auto& cycle = move.cycles[move.numCycles++];
+		cycle.stickers[0] = a;
+		cycle.stickers[1] = b;
+		cycle.stickers[2] = c;
+		cycle.stickers[3] = d;
+	}
+
+	// Same cycles as MoveTable builds at runtime
+	static constexpr MoveCycles BuildMoveCycles()
+	{
+		MoveCycles table{};
+
+		for (auto axis = 0u; axis < MoveTable::NUM_AXES; axis++) {
+			for (auto layer = 0u; layer < N; layer++) {
+				for (auto cw = 0u; cw < 2u; cw++) {
+					auto description = MoveTable::Describe(N, static_cast<MoveTable::Axis>(axis), layer, cw != 0);
+					auto& move = table.moves[MoveIndex(static_cast<MoveTable::Axis>(axis), layer, cw != 0)];
+
+					if (description.turnsFace) {
+						auto f = description.face;
+						auto clockwise = description.faceClockwise;
+
+						for (auto i = 0u; i < N / 2; i++) {
+							for (auto j = i; j < N - i - 1; j++) {
+								auto second = clockwise ? Index(f, N - i - 1, j) : Index(f, i, N - j - 1);
+								auto fourth = clockwise ? Index(f, i, N - j - 1) : Index(f, N - i - 1, j);
+								AddCycle(move, Index(f, j, i), second, Index(f, N - j - 1, N - i - 1), fourth);
+							}
+						}
+					}
+
+					for (auto k = 0u; k < N; k++) {
+						auto& r = description.ring;
+						AddCycle(move,
+							Index(r[0].face, r[0].x + k * r[0].dx, r[0].y + k * r[0].dy),
+							Index(r[1].face, r[1].x + k * r[1].dx, r[1].y + k * r[1].dy),
+							Index(r[2].face, r[2].x + k * r[2].dx, r[2].y + k * r[2].dy),
+							Index(r[3].face, r[3].x + k * r[3].dx, r[3].y + k * r[3].dy));
+					}
+				}
+			}
+		}
+		return table;
+	}
+
+	// Defined after the class is complete, so BuildMoveCycles() can be evaluated
+	static const MoveCycles MOVE_CYCLES;
+
+	std::array<uint8_t, STORAGE_SIZE> m_stickers;
+
+	template<unsigned int M, unsigned int C>
+	void ApplyCycle()
+	{
+		constexpr auto s0 = MOVE_CYCLES.moves[M].cycles[C].stickers[0];
+		constexpr auto s1 = MOVE_CYCLES.moves[M].cycles[C].stickers[1];
+		constexpr auto s2 = MOVE_CYCLES.moves[M].cycles[C].stickers[2];
+		constexpr auto s3 = MOVE_CYCLES.moves[M].cycles[C].stickers[3];
+
+		auto tmp = m_stickers[s0];
+		m_stickers[s0] = m_stickers[s1];
+		m_stickers[s1] = m_stickers[s2];
+		m_stickers[s2] = m_stickers[s3];
+		m_stickers[s3] = tmp;
+	}
+
+	template<unsigned int M, size_t... C>
+	void ApplyCycles(std::index_sequence<C...>)
+	{
+		int expand[] = { (ApplyCycle<M, static_cast<unsigned int>(C)>(), 0)... };
+		(void)expand;
+	}
+
+	template<unsigned int M>
+	void ApplyMove() { ApplyCycles<M>(std::make_index_sequence<MOVE_CYCLES.moves[M].numCycles>()); }
+
+	typedef void (CubeState::*MoveFunction)();
+
+	template<size_t... M>
+	static const MoveFunction* MoveFunctions(std::index_sequence<M...>)
+	{
+		static const MoveFunction functions[] = { &CubeState::ApplyMove<static_cast<unsigned int>(M)>... };
+		return functions;
+	}
+
+	static std::vector<ShuffleKernel::Permutation> BuildShuffles()
+	{
+		std::vector<ShuffleKernel::Permutation> shuffles;
+		shuffles.reserve(NUM_MOVES);
+
+		for (auto m = 0u; m < NUM_MOVES; m++) {
+			uint8_t source[ShuffleKernel::NUM_BYTES];
+
+			for (auto i = 0u; i < NUM_STICKERS; i++) {
+				source[i] = static_cast<uint8_t>(i);
+			}
+			for (auto c = 0u; c < MOVE_CYCLES.moves[m].numCycles; c++) {
+				auto& s = MOVE_CYCLES.moves[m].cycles[c].stickers;
+				source[s[0]] = static_cast<uint8_t>(s[1]);
+				source[s[1]] = static_cast<uint8_t>(s[2]);
+				source[s[2]] = static_cast<uint8_t>(s[3]);
+				source[s[3]] = static_cast<uint8_t>(s[0]);
+			}
+			shuffles.emplace_back(source, static_cast<size_t>(NUM_STICKERS));
+		}
+		return shuffles;
+	}
+
+	// Overloads are picked at compile time, so shuffles are built only for cubes which fit one
+	void RotateDynamic(unsigned int move, std::true_type)
+	{
+		static const auto shuffles = BuildShuffles();
+		ShuffleKernel::Apply(m_stickers.data(), shuffles[move]);
+	}
+
+	void RotateDynamic(unsigned int move, std::false_type)
+	{
+		static const auto functions = MoveFunctions(std::make_index_sequence<NUM_MOVES>());
+		(this->*functions[move])();
+	}
+
+public:
+
+	CubeState() { m_stickers.fill(0); }
+
+	static constexpr unsigned int NumStickersEdge() { return N; }
+
+	uint8_t& At(unsigned int face, unsigned int x, unsigned int y) { return m_stickers[Index(face, x, y)]; }
+	uint8_t At(unsigned int face, unsigned int x, unsigned int y) const { return m_stickers[Index(face, x, y)]; }
+
+	uint8_t* Data() { return m_stickers.data(); }
+	const uint8_t* Data() const { return m_stickers.data(); }
+
+	void FillFace(unsigned int face, uint8_t color)
+		{ std::memset(m_stickers.data() + Index(face, 0, 0), color, N * N); }
+
+	// Move known at compile time
+	template<MoveTable::Axis A, unsigned int L, bool C>
+	void Rotate() { ApplyMove<MoveIndex(A, L, C)>(); }
+
+	// Move known at runtime, dispatched to the shuffle or to the expanded move through a table
+	void Rotate(MoveTable::Axis axis, unsigned int layer, bool clockwise)
+		{ RotateDynamic(MoveIndex(axis, layer, clockwise), std::integral_constant<bool, USES_SHUFFLE>()); }
+};
+
+template<unsigned int N>
+constexpr typename CubeState<N>::MoveCycles CubeState<N>::MOVE_CYCLES = CubeState<N>::BuildMoveCycles();
+
+#endif
\ No newline at end of file
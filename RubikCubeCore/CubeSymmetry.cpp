@@ -0,0 +1,175 @@
+#include "CubeSymmetry.h"
+
+#include <map>
+#include <mutex>
+#include <cstring>
+
+namespace {
+
+// Colors of one image numbered in the order of their first appearance
+class ColorNames {
+private:
+
+	// Sticker colors fit into 3 bits (see PackedStickerStorage)
+	static constexpr unsigned int NUM_COLOR_CODES = 8u;
+
+	uint8_t m_names[NUM_COLOR_CODES];
+	uint8_t m_numNames;
+
+public:
+
+	ColorNames() : m_numNames(0) { std::memset(m_names, 0xFF, sizeof(m_names)); }
+
+	uint8_t Name(uint8_t color)
+	{
+		auto& name = m_names[color & (NUM_COLOR_CODES - 1)];
+		if (name == 0xFF) {
+			name = m_numNames++;
+		}
+		return name;
+	}
+};
+
+// Write the smallest image of stickers with colors named in order of appearance, return its symmetry
+// source(s, i) is the sticker moved onto sticker i by symmetry s
+template <typename Source>
+unsigned int CanonicalImage(size_t numStickers, const uint8_t* stickers, uint8_t* canonical, const Source& source)
+{
+	auto best = 0u;
+	ColorNames bestNames;
+
+	// Only the prefix <0, length) of the best image is written, images mostly differ after few stickers
+	size_t length = 0;
+
+	auto extendBest = [&]() {
+		canonical[length] = bestNames.Name(stickers[source(best, length)]);
+		length++;
+	};
+
+	for (auto s = 1u; s < CubeSymmetry::NUM_SYMMETRIES; s++) {
+		ColorNames names;
+
+		for (size_t i = 0; i < numStickers; i++) {
+			if (i == length) {
+				extendBest();
+			}
+			auto name = names.Name(stickers[source(s, i)]);
+
+			if (name == canonical[i]) {
+				continue;
+			}
+			if (name < canonical[i]) {
+				best = s;
+				bestNames = names;
+				canonical[i] = name;
+				length = i + 1;
+			}
+			break;
+		}
+	}
+
+	while (length < numStickers) {
+		extendBest();
+	}
+	return best;
+}
+
+}
+
+CubeSymmetry::CubeSymmetry(unsigned int numStickersEdge)
+	: m_numStickersEdge(numStickersEdge),
+	m_numStickers(StickerBuffer::NUM_FACES * static_cast<size_t>(numStickersEdge) * numStickersEdge)
+{
+	static const unsigned int permutations[6][3] = { { 0, 1, 2 }, { 1, 2, 0 }, { 2, 0, 1 }, { 0, 2, 1 }, { 2, 1, 0 }, { 1, 0, 2 } };
+
+	// Rotations (determinant 1) fill the first half, the identity stays first
+	auto numRotations = 0u, numReflections = 0u;
+
+	for (auto p = 0u; p < 6u; p++) {
+		for (auto signs = 0u; signs < 8u; signs++) {
+			Symmetry symmetry;
+			auto determinant = (p < 3u) ? 1 : -1;
+
+			for (auto a = 0u; a < 3u; a++) {
+				symmetry.axis[a] = permutations[p][a];
+				symmetry.sign[a] = (signs >> a & 1u) ? -1 : 1;
+				determinant *= symmetry.sign[a];
+			}
+
+			if (determinant > 0) {
+				m_symmetries[numRotations++] = symmetry;
+			}
+			else {
+				m_symmetries[NUM_ROTATIONS + numReflections++] = symmetry;
+			}
+		}
+	}
+
+	if (numStickersEdge <= MAX_TABLE_STICKERS_EDGE) {
+		m_sources.resize(NUM_SYMMETRIES * m_numStickers);
+
+		for (auto s = 0u; s < NUM_SYMMETRIES; s++) {
+			for (size_t i = 0; i < m_numStickers; i++) {
+				m_sources[s * m_numStickers + i] = ComputeSource(s, i);
+			}
+		}
+	}
+}
+
+MoveTable::StickerIndex CubeSymmetry::ComputeSource(unsigned int symmetry, size_t sticker) const
+{
+	auto n = m_numStickersEdge;
+	auto faceStride = static_cast<size_t>(n) * n;
+	auto& s = m_symmetries[symmetry];
+	int image[3], position[3];
+
+	StickerBuffer::StickerPosition(n, static_cast<unsigned int>(sticker / faceStride),
+		static_cast<unsigned int>(sticker % faceStride / n), static_cast<unsigned int>(sticker % n), image);
+
+	// Sticker moved onto the image position
+	for (auto a = 0u; a < 3u; a++) {
+		position[s.axis[a]] = s.sign[a] * image[a];
+	}
+	unsigned int face, x, y;
+	StickerBuffer::StickerAtPosition(n, position, face, x, y);
+	return static_cast<MoveTable::StickerIndex>(face * faceStride + x * n + y);
+}
+
+std::shared_ptr<const CubeSymmetry> CubeSymmetry::ForCubeLevel(unsigned int numStickersEdge)
+{
+	static std::mutex cacheMutex;
+	static std::map<unsigned int, std::weak_ptr<const CubeSymmetry>> cache;
+
+	std::lock_guard<std::mutex> lock(cacheMutex);
+
+	auto& cached = cache[numStickersEdge];
+	auto table = cached.lock();
+
+	if (!table) {
+		table.reset(new CubeSymmetry(numStickersEdge));
+		cached = table;
+	}
+	return table;
+}
+
+void CubeSymmetry::Apply(unsigned int symmetry, const uint8_t* stickers, uint8_t* image) const
+{
+	for (size_t i = 0; i < m_numStickers; i++) {
+		auto source = m_sources.empty() ? ComputeSource(symmetry, i) : m_sources[symmetry * m_numStickers + i];
+		image[i] = stickers[source];
+	}
+}
+
+unsigned int CubeSymmetry::Canonicalize(const uint8_t* stickers, uint8_t* canonical) const
+{
+	if (m_sources.empty()) {
+		return CanonicalImage(m_numStickers, stickers, canonical,
+			[this](unsigned int s, size_t i) { return ComputeSource(s, i); });
+	}
+
+	auto sources = m_sources.data();
+	auto numStickers = m_numStickers;
+
+	return CanonicalImage(m_numStickers, stickers, canonical,
+		[sources, numStickers](unsigned int s, size_t i) { return sources[s * numStickers + i]; });
+}
\ No newline at end of file
@@ -0,0 +1,69 @@
+#ifndef CUBE_SYMMETRY_H
+#define CUBE_SYMMETRY_H
+
+#include "MoveTable.h"
+#include "StickerBuffer.h"
+
+#include <memory>
+#include <vector>
+#include <cstdint>
+
+// The 48 symmetries of the cube (24 rotations and 24 reflections) as sticker permutations for one cube's level
+// Canonical form of stickers is the lexicographically smallest image under all symmetries with colors
+// renamed in the order of their first appearance, so a mirrored cube gets its color scheme back
+// Images are compared sticker by sticker and dropped on the first bigger one
+// Tables are immutable and shared between all cubes of the same level
+class CubeSymmetry final {
+public:
+
+	static constexpr unsigned int NUM_SYMMETRIES = 48u;
+
+	// Symmetries <0, NUM_ROTATIONS) are rotations, 0 is the identity, the rest are reflections
+	static constexpr unsigned int NUM_ROTATIONS = 24u;
+
+	// Bigger cubes compute permutations on the fly, tables would take 1152 bytes per sticker
+	static constexpr unsigned int MAX_TABLE_STICKERS_EDGE = 32u;
+
+private:
+
+	// Symmetry maps doubled coordinates p to q, q[a] = sign[a] * p[axis[a]]
+	struct Symmetry {
+		unsigned int axis[3];
+		int sign[3];
+	};
+
+	unsigned int m_numStickersEdge;
+	size_t m_numStickers;
+	Symmetry m_symmetries[NUM_SYMMETRIES];
+
+	// Sticker i of the image under symmetry s is taken from sticker m_sources[s * m_numStickers + i]
+	std::vector<MoveTable::StickerIndex> m_sources;
+
+	explicit CubeSymmetry(unsigned int numStickersEdge);
+
+	MoveTable::StickerIndex ComputeSource(unsigned int symmetry, size_t sticker) const;
+
+public:
+
+	CubeSymmetry(const CubeSymmetry&) = delete;
+	CubeSymmetry& operator=(const CubeSymmetry&) = delete;
+
+	// Get the table for given cube's level, table is built on first request
+	// and shared as long as somebody holds it
+	static std::shared_ptr<const CubeSymmetry> ForCubeLevel(unsigned int numStickersEdge);
+
+	unsigned int NumStickersEdge() const { return m_numStickersEdge; }
+
+	static bool IsReflection(unsigned int symmetry) { return symmetry >= NUM_ROTATIONS; }
+
+	// Image of stickers under the symmetry, colors are kept
+	// Stickers are face by face, row by row as seen on the cube, buffers must not overlap
+	void Apply(unsigned int symmetry, const uint8_t* stickers, uint8_t* image) const;
+
+	// Write the canonical form of stickers, colors are numbered from 0 in the order of their first appearance
+	// Cubes equal up to a symmetry and renaming of colors have equal canonical forms
+	// Returns the symmetry mapping stickers onto the canonical form
+	unsigned int Canonicalize(const uint8_t* stickers, uint8_t* canonical) const;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,325 @@
+#include "CubieCube.h"
+
+#include <stdexcept>
+#include <vector>
+#include <cstdlib>
+
+// Stickers and moves of all cubie positions of one level
+struct CubieCube::Tables {
+	// Sticker indices of every position, reference sticker first,
+	// corner stickers follow the same handedness on all positions
+	unsigned int corners[NUM_CORNERS][3];
+	unsigned int edges[NUM_EDGES][2];
+	unsigned int centers[NUM_CENTERS];
+
+	// Where the cubie on a position goes and by how much it is twisted
+	struct Move {
+		uint8_t cornerTarget[NUM_CORNERS];
+		uint8_t cornerTwist[NUM_CORNERS];
+		uint8_t edgeTarget[NUM_EDGES];
+		uint8_t edgeFlip[NUM_EDGES];
+		uint8_t centerTarget[NUM_CENTERS];
+	};
+
+	std::vector<Move> moves;
+};
+
+namespace {
+
+// Sticker of one cubie position seen from the outside, normal is the axis the sticker faces
+struct PositionSticker {
+	unsigned int index;
+	unsigned int normal;
+};
+
+struct Position {
+	int cubie[3];
+	std::vector<PositionSticker> stickers;
+};
+
+}
+
+const CubieCube::Tables& CubieCube::GetTables(unsigned int numStickersEdge)
+{
+	auto build = [](unsigned int n) {
+		auto tables = Tables();
+
+		// Group stickers by the cubie they are glued on
+		std::vector<Position> positions;
+
+		for (auto face = 0u; face < StickerBuffer::NUM_FACES; face++) {
+			for (auto x = 0u; x < n; x++) {
+				for (auto y = 0u; y < n; y++) {
+					int p[3];
+					StickerBuffer::StickerPosition(n, face, x, y, p);
+
+					PositionSticker sticker = { (face * n + x) * n + y, 0 };
+					for (auto a = 0u; a < 3u; a++) {
+						if (std::abs(p[a]) == static_cast<int>(n)) {
+							sticker.normal = a;
+							p[a] = (p[a] > 0) ? static_cast<int>(n) - 1 : 1 - static_cast<int>(n);
+						}
+					}
+
+					auto it = positions.begin();
+					while (it != positions.end() && (it->cubie[0] != p[0] || it->cubie[1] != p[1] || it->cubie[2] != p[2])) {
+						++it;
+					}
+					if (it == positions.end()) {
+						positions.push_back({ { p[0], p[1], p[2] }, {} });
+						it = positions.end() - 1;
+					}
+					it->stickers.push_back(sticker);
+				}
+			}
+		}
+
+		auto numCorners = 0u, numEdges = 0u, numCenters = 0u;
+
+		for (auto& position : positions) {
+			auto stickerOn = [&](unsigned int normal) {
+				for (auto& s : position.stickers) {
+					if (s.normal == normal) {
+						return s.index;
+					}
+				}
+				return ~0u;
+			};
+
+			if (position.stickers.size() == 3) {
+				// Keep the same handedness of (first, second, third) normals on all corners
+				auto sign = position.cubie[0] * position.cubie[1] * position.cubie[2];
+				auto& corner = tables.corners[numCorners++];
+				corner[0] = stickerOn(1);
+				corner[1] = stickerOn(sign > 0 ? 2 : 0);
+				corner[2] = stickerOn(sign > 0 ? 0 : 2);
+			}
+			else if (position.stickers.size() == 2) {
+				auto& edge = tables.edges[numEdges++];
+				auto reference = (stickerOn(1) != ~0u) ? 1u : 2u;
+				edge[0] = stickerOn(reference);
+				edge[1] = (position.stickers[0].normal == reference) ? position.stickers[1].index : position.stickers[0].index;
+			}
+			else {
+				tables.centers[numCenters++] = position.stickers[0].index;
+			}
+		}
+
+		// Owner of every sticker: position and index of the sticker inside the position
+		auto numStickers = StickerBuffer::NUM_FACES * n * n;
+		std::vector<unsigned int> ownerPosition(numStickers), ownerSticker(numStickers);
+
+		for (auto p = 0u; p < numCorners; p++) {
+			for (auto k = 0u; k < 3u; k++) {
+				ownerPosition[tables.corners[p][k]] = p;
+				ownerSticker[tables.corners[p][k]] = k;
+			}
+		}
+		for (auto p = 0u; p < numEdges; p++) {
+			for (auto k = 0u; k < 2u; k++) {
+				ownerPosition[tables.edges[p][k]] = p;
+				ownerSticker[tables.edges[p][k]] = k;
+			}
+		}
+		for (auto p = 0u; p < numCenters; p++) {
+			ownerPosition[tables.centers[p]] = p;
+			ownerSticker[tables.centers[p]] = 0;
+		}
+
+		// Perform every move on stickers labeled by their own index
+		auto moveTable = MoveTable::ForCubeLevel(n);
+		StickerBuffer labels(n);
+		std::vector<unsigned int> destination(numStickers);
+
+		for (auto axis = 0u; axis < MoveTable::NUM_AXES; axis++) {
+			for (auto layer = 0u; layer < n; layer++) {
+				for (auto clockwise : { false, true }) {
+					for (auto i = 0u; i < numStickers; i++) {
+						labels.Data()[i] = static_cast<uint8_t>(i);
+					}
+					labels.ResetFaceTurns();
+					moveTable->Apply(labels, static_cast<MoveTable::Axis>(axis), layer, clockwise);
+					labels.Canonicalize();
+
+					for (auto i = 0u; i < numStickers; i++) {
+						destination[labels.Data()[i]] = i;
+					}
+
+					Tables::Move move = {};
+					auto target = [&](const unsigned int* stickers, unsigned int size, uint8_t& position, uint8_t& twist) {
+						position = static_cast<uint8_t>(ownerPosition[destination[stickers[0]]]);
+						twist = static_cast<uint8_t>(ownerSticker[destination[stickers[0]]]);
+
+						// Moves are rotations, so the order of stickers is only shifted
+						for (auto k = 0u; k < size; k++) {
+							auto d = destination[stickers[k]];
+							if (ownerPosition[d] != position || ownerSticker[d] != (k + twist) % size) {
+								throw std::runtime_error("CubieCube: sticker move does not keep cubies together");
+							}
+						}
+					};
+
+					for (auto p = 0u; p < numCorners; p++) {
+						target(tables.corners[p], 3u, move.cornerTarget[p], move.cornerTwist[p]);
+					}
+					for (auto p = 0u; p < numEdges; p++) {
+						target(tables.edges[p], 2u, move.edgeTarget[p], move.edgeFlip[p]);
+					}
+					for (auto p = 0u; p < numCenters; p++) {
+						uint8_t unused;
+						target(&tables.centers[p], 1u, move.centerTarget[p], unused);
+					}
+					tables.moves.push_back(move);
+				}
+			}
+		}
+		return tables;
+	};
+
+	static const Tables tables2 = build(2);
+	static const Tables tables3 = build(3);
+
+	return (numStickersEdge == 2) ? tables2 : tables3;
+}
+
+uint64_t CubieCube::SolvedCorners(unsigned int numStickersEdge)
+{
+	uint64_t corners = 0;
+
+	for (auto p = 0u; p < NUM_CORNERS; p++) {
+		corners |= static_cast<uint64_t>(p) << (p * CORNER_BITS);
+	}
+	if (numStickersEdge == 3) {
+		for (auto p = 0u; p < NUM_CENTERS; p++) {
+			corners |= static_cast<uint64_t>(p) << (CENTERS_SHIFT + p * CENTER_BITS);
+		}
+	}
+	return corners;
+}
+
+uint64_t CubieCube::SolvedEdges(unsigned int numStickersEdge)
+{
+	uint64_t edges = 0;
+
+	if (numStickersEdge == 3) {
+		for (auto p = 0u; p < NUM_EDGES; p++) {
+			edges |= static_cast<uint64_t>(p) << (p * EDGE_BITS);
+		}
+	}
+	return edges;
+}
+
+CubieCube::CubieCube(unsigned int numStickersEdge)
+	: m_numStickersEdge(numStickersEdge)
+{
+	if (!Supports(numStickersEdge)) {
+		throw std::runtime_error("CubieCube: only 2x2x2 and 3x3x3 cubes have cubie representation");
+	}
+	m_tables = &GetTables(numStickersEdge);
+	m_corners = SolvedCorners(numStickersEdge);
+	m_edges = SolvedEdges(numStickersEdge);
+}
+
+void CubieCube::Rotate(MoveTable::Axis axis, unsigned int layer, bool clockwise)
+{
+	auto& move = m_tables->moves[(axis * m_numStickersEdge + layer) * 2u + (clockwise ? 1u : 0u)];
+	uint64_t corners = 0;
+	uint64_t edges = 0;
+
+	for (auto p = 0u; p < NUM_CORNERS; p++) {
+		auto orientation = CornerOrientation(p) + move.cornerTwist[p];
+		orientation -= (orientation >= 3u) ? 3u : 0u;
+		corners |= static_cast<uint64_t>(CornerAt(p) | (orientation << 3)) << (move.cornerTarget[p] * CORNER_BITS);
+	}
+	for (auto p = 0u; p < NumCenters(); p++) {
+		corners |= static_cast<uint64_t>(CenterAt(p)) << (CENTERS_SHIFT + move.centerTarget[p] * CENTER_BITS);
+	}
+	for (auto p = 0u; p < NumEdges(); p++) {
+		auto field = EdgeField(p) ^ (static_cast<unsigned int>(move.edgeFlip[p]) << 4);
+		edges |= static_cast<uint64_t>(field) << (move.edgeTarget[p] * EDGE_BITS);
+	}
+
+	m_corners = corners;
+	m_edges = edges;
+}
+
+void CubieCube::ToStickers(uint8_t* stickers, const uint8_t* faceColors) const
+{
+	auto& tables = *m_tables;
+	auto faceStride = m_numStickersEdge * m_numStickersEdge;
+	auto color = [&](unsigned int sticker) { return faceColors[sticker / faceStride]; };
+
+	for (auto p = 0u; p < NUM_CORNERS; p++) {
+		auto& home = tables.corners[CornerAt(p)];
+		auto orientation = CornerOrientation(p);
+
+		for (auto k = 0u; k < 3u; k++) {
+			stickers[tables.corners[p][(k + orientation) % 3u]] = color(home[k]);
+		}
+	}
+	for (auto p = 0u; p < NumEdges(); p++) {
+		auto& home = tables.edges[EdgeAt(p)];
+		auto orientation = EdgeOrientation(p);
+
+		for (auto k = 0u; k < 2u; k++) {
+			stickers[tables.edges[p][(k + orientation) % 2u]] = color(home[k]);
+		}
+	}
+	for (auto p = 0u; p < NumCenters(); p++) {
+		stickers[tables.centers[p]] = color(tables.centers[CenterAt(p)]);
+	}
+}
+
+CubieCube CubieCube::FromStickers(unsigned int numStickersEdge, const uint8_t* stickers, const uint8_t* faceColors)
+{
+	CubieCube cube(numStickersEdge);
+	auto& tables = *cube.m_tables;
+	auto faceStride = numStickersEdge * numStickersEdge;
+	auto color = [&](unsigned int sticker) { return faceColors[sticker / faceStride]; };
+
+	// Find the cubie and its orientation which matches colors on the position
+	auto match = [&](const unsigned int(*pieces)[3], unsigned int numPieces, unsigned int size,
+		unsigned int position, unsigned int& usedPieces) -> unsigned int {
+		for (auto piece = 0u; piece < numPieces; piece++) {
+			for (auto orientation = 0u; orientation < size; orientation++) {
+				auto matches = true;
+
+				for (auto k = 0u; k < size && matches; k++) {
+					matches = stickers[pieces[position][(k + orientation) % size]] == color(pieces[piece][k]);
+				}
+				if (matches && (usedPieces & (1u << piece)) == 0) {
+					usedPieces |= 1u << piece;
+					return piece | (orientation << (size == 3 ? 3 : 4));
+				}
+			}
+		}
+		throw std::runtime_error("CubieCube: stickers do not form cubies of the solved cube");
+	};
+
+	unsigned int edgeStickers[NUM_EDGES][3];
+	unsigned int centerStickers[NUM_CENTERS][3];
+
+	for (auto p = 0u; p < NUM_EDGES; p++) {
+		edgeStickers[p][0] = tables.edges[p][0];
+		edgeStickers[p][1] = tables.edges[p][1];
+	}
+	for (auto p = 0u; p < NUM_CENTERS; p++) {
+		centerStickers[p][0] = tables.centers[p];
+	}
+
+	auto usedCorners = 0u, usedEdges = 0u, usedCenters = 0u;
+	cube.m_corners = 0;
+	cube.m_edges = 0;
+
+	for (auto p = 0u; p < NUM_CORNERS; p++) {
+		cube.m_corners |= static_cast<uint64_t>(match(tables.corners, NUM_CORNERS, 3u, p, usedCorners)) << (p * CORNER_BITS);
+	}
+	for (auto p = 0u; p < cube.NumCenters(); p++) {
+		cube.m_corners |= static_cast<uint64_t>(match(centerStickers, NUM_CENTERS, 1u, p, usedCenters))
+			<< (CENTERS_SHIFT + p * CENTER_BITS);
+	}
+	for (auto p = 0u; p < cube.NumEdges(); p++) {
+		cube.m_edges |= static_cast<uint64_t>(match(edgeStickers, NUM_EDGES, 2u, p, usedEdges)) << (p * EDGE_BITS);
+	}
+	return cube;
+}
\ No newline at end of file
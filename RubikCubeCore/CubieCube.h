@@ -0,0 +1,86 @@
+#ifndef CUBIE_CUBE_H
+#define CUBIE_CUBE_H
+
+#include "MoveTable.h"
+#include "StickerBuffer.h"
+
+#include <cstdint>
+
+// Cubie-level state of 2x2x2 and 3x3x3 cubes: which cubie sits on every position and how it is twisted
+// Every corner takes 5 bits (3 bits cubie, 2 bits orientation), the corner word also holds
+// 6 centers (3 bits each) of 3x3x3 cube, every edge takes 5 bits (4 bits cubie, 1 bit orientation)
+// 2x2x2 cube has corners only
+// Orientation 0 means the reference sticker of the cubie (top/bottom one, front/back one for middle edges)
+// lies on the reference sticker of the position
+// Moves are table lookups, tables are derived from sticker moves once per level
+class CubieCube final {
+public:
+
+	static constexpr unsigned int NUM_CORNERS = 8u;
+	static constexpr unsigned int NUM_EDGES = 12u;
+	static constexpr unsigned int NUM_CENTERS = StickerBuffer::NUM_FACES;
+
+private:
+
+	static constexpr unsigned int CORNER_BITS = 5u;
+	static constexpr unsigned int EDGE_BITS = 5u;
+	static constexpr unsigned int CENTER_BITS = 3u;
+	static constexpr unsigned int CENTERS_SHIFT = NUM_CORNERS * CORNER_BITS;
+
+	struct Tables;
+
+	unsigned int m_numStickersEdge;
+	const Tables* m_tables;
+	uint64_t m_corners;
+	uint64_t m_edges;
+
+	static const Tables& GetTables(unsigned int numStickersEdge);
+
+	unsigned int CornerField(unsigned int position) const
+		{ return static_cast<unsigned int>(m_corners >> (position * CORNER_BITS)) & ((1u << CORNER_BITS) - 1u); }
+	unsigned int EdgeField(unsigned int position) const
+		{ return static_cast<unsigned int>(m_edges >> (position * EDGE_BITS)) & ((1u << EDGE_BITS) - 1u); }
+
+	static uint64_t SolvedCorners(unsigned int numStickersEdge);
+	static uint64_t SolvedEdges(unsigned int numStickersEdge);
+
+public:
+
+	// Solved cube, throws an exception if the level has no cubie representation
+	explicit CubieCube(unsigned int numStickersEdge = 3);
+
+	static bool Supports(unsigned int numStickersEdge) { return numStickersEdge == 2 || numStickersEdge == 3; }
+
+	unsigned int NumStickersEdge() const { return m_numStickersEdge; }
+	unsigned int NumEdges() const { return m_numStickersEdge == 3 ? NUM_EDGES : 0u; }
+	unsigned int NumCenters() const { return m_numStickersEdge == 3 ? NUM_CENTERS : 0u; }
+
+	unsigned int CornerAt(unsigned int position) const { return CornerField(position) & 7u; }
+	unsigned int CornerOrientation(unsigned int position) const { return CornerField(position) >> 3; }
+	unsigned int EdgeAt(unsigned int position) const { return EdgeField(position) & 15u; }
+	unsigned int EdgeOrientation(unsigned int position) const { return EdgeField(position) >> 4; }
+	unsigned int CenterAt(unsigned int position) const
+		{ return static_cast<unsigned int>(m_corners >> (CENTERS_SHIFT + position * CENTER_BITS)) & 7u; }
+
+	// Packed state, equal words mean equal cubes
+	uint64_t CornerWord() const { return m_corners; }
+	uint64_t EdgeWord() const { return m_edges; }
+
+	bool IsSolved() const
+		{ return m_corners == SolvedCorners(m_numStickersEdge) && m_edges == SolvedEdges(m_numStickersEdge); }
+
+	bool operator==(const CubieCube& c) const
+		{ return m_numStickersEdge == c.m_numStickersEdge && m_corners == c.m_corners && m_edges == c.m_edges; }
+	bool operator!=(const CubieCube& c) const { return !(*this == c); }
+
+	void Rotate(MoveTable::Axis axis, unsigned int layer, bool clockwise);
+
+	// Stickers in the StickerBuffer layout (face by face, row by row as seen on the cube)
+	// faceColors are colors of faces of the solved cube
+	void ToStickers(uint8_t* stickers, const uint8_t* faceColors) const;
+
+	// Throws an exception if stickers do not form cubies of the solved cube with given face colors
+	static CubieCube FromStickers(unsigned int numStickersEdge, const uint8_t* stickers, const uint8_t* faceColors);
+};
+
+#endif
\ No newline at end of file
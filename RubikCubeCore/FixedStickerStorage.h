@@ -0,0 +1,33 @@
+#ifndef FIXED_STICKER_STORAGE_H
+#define FIXED_STICKER_STORAGE_H
+
+#include "StickerStorage.h"
+#include "CubeState.h"
+
+#include <memory>
+#include <cstring>
+
+// Storage of cubes whose level is one of CubeState specializations,
+// moves do not pay for runtime-sized loops nor for face orientation tags
+template<unsigned int N>
+class FixedStickerStorage final : public StickerStorage {
+private:
+
+	CubeState<N> m_state;
+
+public:
+
+	unsigned int NumStickersEdge() const override { return N; }
+	std::unique_ptr<StickerStorage> Clone() const override { return std::make_unique<FixedStickerStorage<N>>(*this); }
+
+	uint8_t Get(unsigned int face, unsigned int x, unsigned int y) const override { return m_state.At(face, x, y); }
+	void FillFace(unsigned int face, uint8_t color) override { m_state.FillFace(face, color); }
+
+	void Rotate(MoveTable::Axis axis, unsigned int layer, bool clockwise) override
+		{ m_state.Rotate(axis, layer, clockwise); }
+
+	void Read(uint8_t* stickers) const override { std::memcpy(stickers, m_state.Data(), CubeState<N>::NUM_STICKERS); }
+	void Write(const uint8_t* stickers) override { std::memcpy(m_state.Data(), stickers, CubeState<N>::NUM_STICKERS); }
+};
+
+#endif
\ No newline at end of file
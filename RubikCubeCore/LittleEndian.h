@@ -0,0 +1,27 @@
+#ifndef LITTLE_ENDIAN_H
+#define LITTLE_ENDIAN_H
+
+#include <cstdint>
+#include <cstddef>
+
+// Numbers of binary files are stored little endian byte by byte, so files do not depend on the platform
+struct LittleEndian {
+	static void Write(uint8_t* data, uint64_t value, size_t size)
+	{
+		for (size_t i = 0; i < size; i++) {
+			data[i] = static_cast<uint8_t>(value >> (8u * i));
+		}
+	}
+
+	static uint64_t Read(const uint8_t* data, size_t size)
+	{
+		uint64_t value = 0;
+
+		for (size_t i = 0; i < size; i++) {
+			value |= static_cast<uint64_t>(data[i]) << (8u * i);
+		}
+		return value;
+	}
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,183 @@
+#include "MoveHistory.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+MoveHistory::MoveHistory(size_t depth)
+	: m_first(0),
+	m_size(0),
+	m_position(0),
+	m_numSpilled(0)
+{
+	SetDepth(depth);
+}
+
+uint32_t MoveHistory::Pack(const MoveTable::Move& move)
+{
+	return static_cast<uint32_t>(move.axis) | (move.clockwise ? 0u : 4u) | move.layer << LAYER_SHIFT;
+}
+
+MoveTable::Move MoveHistory::Unpack(uint32_t record)
+{
+	return{ static_cast<MoveTable::Axis>(record & 3u), record >> LAYER_SHIFT, (record & 4u) == 0 };
+}
+
+void MoveHistory::SetDepth(size_t depth)
+{
+	if (depth == 0) {
+		throw std::runtime_error("History depth cannot be zero");
+	}
+
+	std::vector<uint32_t> records;
+	records.reserve(m_position);
+
+	for (size_t i = 0; i < m_position; i++) {
+		records.push_back(At(i));
+	}
+
+	m_records.assign(depth, 0u);
+	m_first = 0;
+	m_size = 0;
+	m_position = 0;
+
+	for (auto record : records) {
+		Push(record);
+	}
+}
+
+void MoveHistory::SetSpillFile(const std::string& filepath)
+{
+	if (m_spill.is_open()) {
+		m_spill.close();
+	}
+	m_numSpilled = 0;
+
+	if (filepath.empty()) {
+		return;
+	}
+	m_spill.open(filepath, std::fstream::in | std::fstream::out | std::fstream::binary | std::fstream::trunc);
+
+	if (!m_spill.good()) {
+		throw std::runtime_error("Unable to create history spill file");
+	}
+}
+
+void MoveHistory::Push(uint32_t record)
+{
+	m_size = m_position;
+
+	if (m_size == m_records.size()) {
+		if (m_spill.is_open()) {
+			Spill();
+		}
+		else {
+			m_first = (m_first + 1u) % m_records.size();
+			m_size--;
+			m_position--;
+		}
+	}
+	At(m_size) = record;
+	m_size++;
+	m_position++;
+}
+
+void MoveHistory::Spill()
+{
+	auto count = BlockSize();
+	std::vector<uint32_t> block(count);
+
+	for (size_t i = 0; i < count; i++) {
+		block[i] = At(i);
+	}
+
+	m_spill.seekp(m_numSpilled * RECORD_SIZE);
+	m_spill.write(reinterpret_cast<const char*>(block.data()), count * RECORD_SIZE);
+
+	if (!m_spill.good()) {
+		throw std::runtime_error("Unable to write history spill file");
+	}
+	m_numSpilled += count;
+	m_first = (m_first + count) % m_records.size();
+	m_size -= count;
+	m_position -= count;
+}
+
+void MoveHistory::Unspill()
+{
+	auto count = static_cast<size_t>(std::min<uint64_t>(m_numSpilled, BlockSize()));
+	std::vector<uint32_t> block(count);
+
+	m_spill.seekg((m_numSpilled - count) * RECORD_SIZE);
+	m_spill.read(reinterpret_cast<char*>(block.data()), count * RECORD_SIZE);
+
+	if (static_cast<size_t>(m_spill.gcount()) != count * RECORD_SIZE) {
+		throw std::runtime_error("Unable to read history spill file");
+	}
+
+	// The farthest undone moves make room for the block
+	m_size = std::min(m_size, m_records.size() - count);
+	m_first = (m_first + m_records.size() - count) % m_records.size();
+
+	for (size_t i = 0; i < count; i++) {
+		At(i) = block[i];
+	}
+	m_numSpilled -= count;
+	m_size += count;
+	m_position += count;
+}
+
+bool MoveHistory::Undo(MoveTable::Move& inverse)
+{
+	if (m_position == 0) {
+		if (m_numSpilled == 0) {
+			return false;
+		}
+		Unspill();
+	}
+	m_position--;
+	inverse = Unpack(At(m_position));
+	inverse.clockwise = !inverse.clockwise;
+	return true;
+}
+
+bool MoveHistory::Redo(MoveTable::Move& move)
+{
+	if (m_position == m_size) {
+		return false;
+	}
+	move = Unpack(At(m_position));
+	m_position++;
+	return true;
+}
+
+void MoveHistory::Clear()
+{
+	m_first = 0;
+	m_size = 0;
+	m_position = 0;
+	m_numSpilled = 0;
+}
+
+void MoveHistory::ForEachMove(const std::function<void(const MoveTable::Move&)>& function)
+{
+	std::vector<uint32_t> block(BlockSize());
+
+	for (uint64_t spilled = 0; spilled < m_numSpilled;) {
+		auto count = static_cast<size_t>(std::min<uint64_t>(m_numSpilled - spilled, block.size()));
+
+		m_spill.seekg(spilled * RECORD_SIZE);
+		m_spill.read(reinterpret_cast<char*>(block.data()), count * RECORD_SIZE);
+
+		if (static_cast<size_t>(m_spill.gcount()) != count * RECORD_SIZE) {
+			throw std::runtime_error("Unable to read history spill file");
+		}
+		for (size_t i = 0; i < count; i++) {
+			function(Unpack(block[i]));
+		}
+		spilled += count;
+	}
+
+	for (size_t i = 0; i < m_position; i++) {
+		function(Unpack(At(i)));
+	}
+}
\ No newline at end of file
@@ -0,0 +1,92 @@
+#ifndef MOVE_HISTORY_H
+#define MOVE_HISTORY_H
+
+#include "MoveTable.h"
+
+#include <fstream>
+#include <functional>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Performed moves with undo and redo, every move is a 32 bit record in a ring of fixed depth
+// When the ring is full the oldest moves are dropped, or spilled into a file in blocks of half the ring,
+// so memory stays bounded however long the session is
+// Undone moves stay behind the cursor for redo until another move is pushed
+class MoveHistory final {
+public:
+
+	static constexpr size_t DEFAULT_DEPTH = 1u << 16;
+
+private:
+
+	// Record: bits 0-1 axis, bit 2 counter-clockwise, bits 3-31 layer
+	static constexpr unsigned int LAYER_SHIFT = 3u;
+	static constexpr size_t RECORD_SIZE = sizeof(uint32_t);
+
+	std::vector<uint32_t> m_records;
+
+	// Ring index of the oldest record, records in the ring (done and undone) and done records
+	size_t m_first;
+	size_t m_size;
+	size_t m_position;
+
+	// Oldest done moves are in the spill file if it is open
+	std::fstream m_spill;
+	uint64_t m_numSpilled;
+
+	static uint32_t Pack(const MoveTable::Move& move);
+	static MoveTable::Move Unpack(uint32_t record);
+
+	uint32_t& At(size_t i) { return m_records[(m_first + i) % m_records.size()]; }
+
+	size_t BlockSize() const { return (m_records.size() + 1u) / 2u; }
+
+	void Push(uint32_t record);
+
+	// Move the oldest block of the ring into the spill file
+	void Spill();
+
+	// Move the newest spilled block in front of the ring, undone moves are dropped if there is no room
+	void Unspill();
+
+public:
+
+	explicit MoveHistory(size_t depth = DEFAULT_DEPTH);
+
+	MoveHistory(const MoveHistory&) = delete;
+	MoveHistory& operator=(const MoveHistory&) = delete;
+
+	size_t GetDepth() const { return m_records.size(); }
+
+	// Keeps the latest done moves which fit, undone moves are dropped
+	// Throws an exception if depth is zero
+	void SetDepth(size_t depth);
+
+	// Spill moves which do not fit into the ring into the file, an empty path drops them instead
+	// Moves spilled so far are dropped, throws an exception if the file can not be created
+	void SetSpillFile(const std::string& filepath);
+
+	bool IsSpilling() const { return m_spill.is_open(); }
+
+	// Record a performed move, undone moves are dropped
+	void Push(const MoveTable::Move& move) { Push(Pack(move)); }
+
+	// Inverse of the latest done move, false if there is nothing to undo
+	bool Undo(MoveTable::Move& inverse);
+
+	// The latest undone move, false if there is nothing to redo
+	bool Redo(MoveTable::Move& move);
+
+	void Clear();
+
+	// Done moves including spilled ones
+	uint64_t NumMoves() const { return m_numSpilled + m_position; }
+	size_t NumUndoneMoves() const { return m_size - m_position; }
+
+	// Call the function for all done moves from the oldest on, spilled moves are read back in blocks
+	void ForEachMove(const std::function<void(const MoveTable::Move&)>& function);
+};
+
+#endif
\ No newline at end of file
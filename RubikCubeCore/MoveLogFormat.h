@@ -0,0 +1,74 @@
+#ifndef MOVE_LOG_FORMAT_H
+#define MOVE_LOG_FORMAT_H
+
+#include "LittleEndian.h"
+#include "MoveTable.h"
+
+#include <cstdint>
+#include <cstddef>
+
+// Binary move log, all numbers are little endian:
+//   header: magic "RCML", version (16 bits), flags (16 bits), cube's level (32 bits), number of moves (64 bits)
+//     the number of moves is INCOMPLETE_NUM_MOVES until the writer is closed
+//   moves: one byte per move, layers far from both outer ones are followed by a varint
+//   checksum: FNV-1a of all move bytes (64 bits), only with CHECKSUM_FLAG
+// Move byte: bits 0-1 axis, bit 2 counter-clockwise, bits 3-7 layer code
+//   codes 0-15 are layers from the first one on, codes 16-30 layers from the last one back,
+//   code 31 is followed by the layer as a varint
+struct MoveLogFormat {
+	// "RCML" read as a little endian number
+	static constexpr uint32_t MAGIC = 0x4C4D4352u;
+	static constexpr uint16_t VERSION = 1u;
+	static constexpr uint16_t CHECKSUM_FLAG = 1u;
+
+	static constexpr size_t HEADER_SIZE = 20u;
+	static constexpr size_t CHECKSUM_SIZE = 8u;
+
+	// Move byte and varint of 32 bit layer
+	static constexpr size_t MAX_MOVE_SIZE = 6u;
+
+	static constexpr unsigned int NUM_NEAR_LAYERS = 16u;
+	static constexpr unsigned int NUM_FAR_LAYERS = 15u;
+	static constexpr unsigned int VARINT_LAYER = 31u;
+
+	// Number of moves of a log whose writer was not closed
+	static constexpr uint64_t INCOMPLETE_NUM_MOVES = UINT64_MAX;
+
+	static constexpr uint64_t CHECKSUM_SEED = 14695981039346656037ull;
+
+	static uint64_t UpdateChecksum(uint64_t checksum, const uint8_t* data, size_t size)
+	{
+		for (size_t i = 0; i < size; i++) {
+			checksum = (checksum ^ data[i]) * 1099511628211ull;
+		}
+		return checksum;
+	}
+
+	// Write at most MAX_MOVE_SIZE bytes of the move, returns the number of bytes
+	static size_t EncodeMove(const MoveTable::Move& move, unsigned int numStickersEdge, uint8_t* data)
+	{
+		auto head = static_cast<unsigned int>(move.axis) | (move.clockwise ? 0u : 4u);
+		auto far = numStickersEdge - 1u - move.layer;
+
+		if (move.layer < NUM_NEAR_LAYERS) {
+			data[0] = static_cast<uint8_t>(head | move.layer << 3);
+			return 1u;
+		}
+		if (far < NUM_FAR_LAYERS) {
+			data[0] = static_cast<uint8_t>(head | (NUM_NEAR_LAYERS + far) << 3);
+			return 1u;
+		}
+		data[0] = static_cast<uint8_t>(head | VARINT_LAYER << 3);
+
+		size_t size = 1u;
+		auto layer = move.layer;
+
+		for (; layer >= 0x80u; layer >>= 7) {
+			data[size++] = static_cast<uint8_t>(layer | 0x80u);
+		}
+		data[size++] = static_cast<uint8_t>(layer);
+		return size;
+	}
+};
+
+#endif
\ No newline at end of file
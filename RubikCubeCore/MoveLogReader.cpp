@@ -0,0 +1,160 @@
+#include "MoveLogReader.h"
+
+#include <stdexcept>
+#include <cstring>
+
+MoveLogReader::MoveLogReader(const std::string& filepath)
+	: m_file(filepath, std::ifstream::in | std::ifstream::binary),
+	m_chunk(new uint8_t[CHUNK_SIZE]),
+	m_begin(0),
+	m_end(0),
+	m_checksumEnd(0),
+	m_endOfFile(false),
+	m_bytesRead(0),
+	m_checksum(MoveLogFormat::CHECKSUM_SEED),
+	m_numMovesRead(0)
+{
+	if (!m_file.good()) {
+		throw std::runtime_error("Unable to open savefile");
+	}
+	FillChunk();
+
+	if (m_end < MoveLogFormat::HEADER_SIZE || LittleEndian::Read(m_chunk.get(), 4u) != MoveLogFormat::MAGIC) {
+		throw std::runtime_error("File is not a move log");
+	}
+
+	auto header = m_chunk.get();
+	auto version = LittleEndian::Read(header + 4, 2u);
+	auto flags = LittleEndian::Read(header + 6, 2u);
+
+	if (version != MoveLogFormat::VERSION) {
+		throw std::runtime_error("Unsupported move log version");
+	}
+	m_checksumEnabled = (flags & MoveLogFormat::CHECKSUM_FLAG) != 0;
+	m_numStickersEdge = static_cast<unsigned int>(LittleEndian::Read(header + 8, 4u));
+	m_numMoves = LittleEndian::Read(header + 12, 8u);
+
+	if (m_numMoves == MoveLogFormat::INCOMPLETE_NUM_MOVES) {
+		throw std::runtime_error("Move log is incomplete");
+	}
+	if (m_numStickersEdge == 0) {
+		throw std::runtime_error("Invalid number of stickers per edge in move log");
+	}
+	m_begin = MoveLogFormat::HEADER_SIZE;
+	m_checksumEnd = m_begin;
+}
+
+bool MoveLogReader::IsMoveLog(const std::string& filepath)
+{
+	std::ifstream file(filepath, std::ifstream::in | std::ifstream::binary);
+	uint8_t magic[4];
+
+	file.read(reinterpret_cast<char*>(magic), sizeof(magic));
+	return file.gcount() == sizeof(magic) && LittleEndian::Read(magic, sizeof(magic)) == MoveLogFormat::MAGIC;
+}
+
+bool MoveLogReader::FillChunk()
+{
+	if (m_endOfFile) {
+		return false;
+	}
+	UpdateChecksum();
+
+	auto remaining = m_end - m_begin;
+	std::memmove(m_chunk.get(), m_chunk.get() + m_begin, remaining);
+	m_begin = 0;
+	m_end = remaining;
+	m_checksumEnd = 0;
+
+	m_file.read(reinterpret_cast<char*>(m_chunk.get() + m_end), CHUNK_SIZE - m_end);
+	auto numRead = static_cast<size_t>(m_file.gcount());
+
+	if (!m_file.good()) {
+		m_endOfFile = true;
+	}
+	m_end += numRead;
+	m_bytesRead += numRead;
+	return numRead > 0;
+}
+
+void MoveLogReader::UpdateChecksum()
+{
+	if (m_checksumEnabled) {
+		m_checksum = MoveLogFormat::UpdateChecksum(m_checksum, m_chunk.get() + m_checksumEnd, m_begin - m_checksumEnd);
+	}
+	m_checksumEnd = m_begin;
+}
+
+void MoveLogReader::VerifyChecksum()
+{
+	UpdateChecksum();
+
+	if (m_end - m_begin < MoveLogFormat::CHECKSUM_SIZE) {
+		FillChunk();
+	}
+	if (m_end - m_begin < MoveLogFormat::CHECKSUM_SIZE) {
+		throw std::runtime_error("Move log is truncated");
+	}
+	if (LittleEndian::Read(m_chunk.get() + m_begin, MoveLogFormat::CHECKSUM_SIZE) != m_checksum) {
+		throw std::runtime_error("Move log checksum does not match");
+	}
+	m_begin += MoveLogFormat::CHECKSUM_SIZE;
+}
+
+bool MoveLogReader::ReadMoves(std::vector<MoveTable::Move>& moves, size_t maxMoves)
+{
+	moves.clear();
+
+	auto n = m_numStickersEdge;
+	auto last = n - 1u;
+
+	while (moves.size() < maxMoves && m_numMovesRead < m_numMoves) {
+		// A whole move is in the chunk unless the file ends
+		if (m_end - m_begin < MoveLogFormat::MAX_MOVE_SIZE && FillChunk()) {
+			continue;
+		}
+		if (m_begin == m_end) {
+			throw std::runtime_error("Move log is truncated");
+		}
+
+		auto byte = m_chunk[m_begin++];
+		auto axis = byte & 3u;
+		auto code = static_cast<unsigned int>(byte >> 3);
+		uint64_t layer = code;
+
+		if (code >= MoveLogFormat::VARINT_LAYER) {
+			layer = 0;
+
+			for (auto shift = 0u;; shift += 7u) {
+				if (m_begin == m_end) {
+					throw std::runtime_error("Move log is truncated");
+				}
+				if (shift > 28u) {
+					throw std::runtime_error("Move log is corrupted");
+				}
+				auto varintByte = m_chunk[m_begin++];
+				layer |= static_cast<uint64_t>(varintByte & 0x7Fu) << shift;
+
+				if ((varintByte & 0x80u) == 0) {
+					break;
+				}
+			}
+		}
+		else if (code >= MoveLogFormat::NUM_NEAR_LAYERS) {
+			// Layers from the last one back, small cubes may not have them
+			auto far = code - MoveLogFormat::NUM_NEAR_LAYERS;
+			layer = far <= last ? last - far : n;
+		}
+
+		if (axis >= MoveTable::NUM_AXES || layer >= n) {
+			throw std::runtime_error("Move log is corrupted");
+		}
+		moves.push_back({ static_cast<MoveTable::Axis>(axis), static_cast<unsigned int>(layer), (byte & 4u) == 0 });
+		m_numMovesRead++;
+
+		if (m_numMovesRead == m_numMoves && m_checksumEnabled) {
+			VerifyChecksum();
+		}
+	}
+	return !moves.empty();
+}
\ No newline at end of file
@@ -0,0 +1,66 @@
+#ifndef MOVE_LOG_READER_H
+#define MOVE_LOG_READER_H
+
+#include "MoveLogFormat.h"
+
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Reader of binary move logs (see MoveLogFormat) of any size, the file is read in big chunks
+class MoveLogReader final {
+private:
+
+	static constexpr size_t CHUNK_SIZE = 1u << 20;
+
+	std::ifstream m_file;
+	std::unique_ptr<uint8_t[]> m_chunk;
+
+	// Unread bytes of the chunk are [m_begin, m_end), bytes before m_checksumEnd are in m_checksum
+	size_t m_begin;
+	size_t m_end;
+	size_t m_checksumEnd;
+	bool m_endOfFile;
+	uint64_t m_bytesRead;
+
+	unsigned int m_numStickersEdge;
+	bool m_checksumEnabled;
+	uint64_t m_checksum;
+	uint64_t m_numMoves;
+	uint64_t m_numMovesRead;
+
+	// Move unread bytes to the front and read more behind them, false if nothing was read
+	bool FillChunk();
+
+	// Add move bytes read so far into the checksum
+	void UpdateChecksum();
+
+	// Check the checksum behind the last move
+	void VerifyChecksum();
+
+public:
+
+	// Reads the header, throws an exception if the file is not a complete move log of supported version
+	explicit MoveLogReader(const std::string& filepath);
+
+	MoveLogReader(const MoveLogReader&) = delete;
+	MoveLogReader& operator=(const MoveLogReader&) = delete;
+
+	// True if the file starts with the move log's magic
+	static bool IsMoveLog(const std::string& filepath);
+
+	// Level of the cube the moves were recorded for
+	unsigned int NumStickersEdge() const { return m_numStickersEdge; }
+	uint64_t NumMoves() const { return m_numMoves; }
+
+	// Replace content of moves with up to maxMoves next moves, false if there are no more moves
+	// Throws an exception if the log is truncated or corrupted, the checksum is checked after the last move
+	bool ReadMoves(std::vector<MoveTable::Move>& moves, size_t maxMoves);
+
+	uint64_t BytesRead() const { return m_bytesRead; }
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,82 @@
+#include "MoveLogWriter.h"
+
+#include <stdexcept>
+
+MoveLogWriter::MoveLogWriter(const std::string& filepath, unsigned int numStickersEdge, bool checksumEnabled)
+	: m_file(filepath, std::ofstream::out | std::ofstream::binary | std::ofstream::trunc),
+	m_numStickersEdge(numStickersEdge),
+	m_checksumEnabled(checksumEnabled),
+	m_checksum(MoveLogFormat::CHECKSUM_SEED),
+	m_numMoves(0),
+	m_buffer(BUFFER_SIZE + MoveLogFormat::MAX_MOVE_SIZE),
+	m_bufferSize(0)
+{
+	if (!m_file.good()) {
+		throw std::runtime_error("Unable to create file for saving");
+	}
+
+	// The number of moves is not known yet, Close() writes the header again
+	WriteHeader(MoveLogFormat::INCOMPLETE_NUM_MOVES);
+}
+
+MoveLogWriter::~MoveLogWriter()
+{
+	if (m_file.is_open()) {
+		m_file.write(reinterpret_cast<const char*>(m_buffer.data()), m_bufferSize);
+	}
+}
+
+void MoveLogWriter::Flush()
+{
+	if (m_checksumEnabled) {
+		m_checksum = MoveLogFormat::UpdateChecksum(m_checksum, m_buffer.data(), m_bufferSize);
+	}
+	m_file.write(reinterpret_cast<const char*>(m_buffer.data()), m_bufferSize);
+	m_bufferSize = 0;
+}
+
+void MoveLogWriter::WriteHeader(uint64_t numMoves)
+{
+	uint8_t header[MoveLogFormat::HEADER_SIZE];
+	LittleEndian::Write(header, MoveLogFormat::MAGIC, 4u);
+	LittleEndian::Write(header + 4, MoveLogFormat::VERSION, 2u);
+	LittleEndian::Write(header + 6, m_checksumEnabled ? MoveLogFormat::CHECKSUM_FLAG : 0u, 2u);
+	LittleEndian::Write(header + 8, m_numStickersEdge, 4u);
+	LittleEndian::Write(header + 12, numMoves, 8u);
+	m_file.write(reinterpret_cast<const char*>(header), sizeof(header));
+}
+
+void MoveLogWriter::Write(const MoveTable::Move& move)
+{
+	if (move.axis >= MoveTable::NUM_AXES || move.layer >= m_numStickersEdge) {
+		throw std::runtime_error("Move does not fit the cube's level");
+	}
+	m_bufferSize += MoveLogFormat::EncodeMove(move, m_numStickersEdge, m_buffer.data() + m_bufferSize);
+	m_numMoves++;
+
+	if (m_bufferSize >= BUFFER_SIZE) {
+		Flush();
+	}
+}
+
+void MoveLogWriter::Close()
+{
+	Flush();
+
+	if (m_checksumEnabled) {
+		uint8_t checksum[MoveLogFormat::CHECKSUM_SIZE];
+		LittleEndian::Write(checksum, m_checksum, sizeof(checksum));
+		m_file.write(reinterpret_cast<const char*>(checksum), sizeof(checksum));
+	}
+
+	// Nothing is marked complete if some write failed
+	if (!m_file.fail()) {
+		m_file.seekp(0);
+		WriteHeader(m_numMoves);
+	}
+	m_file.close();
+
+	if (m_file.fail()) {
+		throw std::runtime_error("Unable to write move log");
+	}
+}
\ No newline at end of file
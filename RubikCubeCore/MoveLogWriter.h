@@ -0,0 +1,47 @@
+#ifndef MOVE_LOG_WRITER_H
+#define MOVE_LOG_WRITER_H
+
+#include "MoveLogFormat.h"
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// Writes moves into a binary move log (see MoveLogFormat) through a buffer
+// The number of moves and the checksum are written by Close(), a log which is not closed stays marked incomplete
+class MoveLogWriter final {
+private:
+
+	static constexpr size_t BUFFER_SIZE = 1u << 16;
+
+	std::ofstream m_file;
+	unsigned int m_numStickersEdge;
+	bool m_checksumEnabled;
+	uint64_t m_checksum;
+	uint64_t m_numMoves;
+	std::vector<uint8_t> m_buffer;
+	size_t m_bufferSize;
+
+	void Flush();
+
+	void WriteHeader(uint64_t numMoves);
+
+public:
+
+	// Moves are recorded for the cube of given level
+	MoveLogWriter(const std::string& filepath, unsigned int numStickersEdge, bool checksumEnabled = true);
+
+	// Moves written so far are kept if Close() was not called, the log stays marked incomplete
+	~MoveLogWriter();
+
+	MoveLogWriter(const MoveLogWriter&) = delete;
+	MoveLogWriter& operator=(const MoveLogWriter&) = delete;
+
+	// Throws an exception if the move does not fit the cube's level
+	void Write(const MoveTable::Move& move);
+
+	void Close();
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,165 @@
+#include "MoveTable.h"
+
+#include <map>
+#include <mutex>
+
+MoveTable::MoveTable(unsigned int numStickersEdge)
+	: m_numStickersEdge(numStickersEdge)
+{
+	if (numStickersEdge > MAX_CYCLE_TABLE_STICKERS_EDGE) {
+		return;
+	}
+
+	// Outer layers rotate the whole face, all layers shift one ring of stickers
+	size_t ringCycles = 3u * numStickersEdge * numStickersEdge;
+	size_t faceCycles = 6u * (numStickersEdge * numStickersEdge / 4u);
+
+	m_offsets.reserve(NUM_AXES * numStickersEdge * 2u + 1u);
+	m_cycles.reserve(2u * (ringCycles + faceCycles));
+
+	for (auto axis = 0u; axis < NUM_AXES; axis++) {
+		for (auto layer = 0u; layer < numStickersEdge; layer++) {
+			for (auto clockwise : { false, true }) {
+				m_offsets.push_back(static_cast<uint32_t>(m_cycles.size()));
+				AddMoveCycles(Describe(static_cast<Axis>(axis), layer, clockwise));
+			}
+		}
+	}
+	m_offsets.push_back(static_cast<uint32_t>(m_cycles.size()));
+
+	if (ShuffleKernel::Fits(6u * numStickersEdge * numStickersEdge)) {
+		BuildShuffles();
+	}
+}
+
+void MoveTable::AddFaceCycles(unsigned int face, bool clockwise)
+{
+	auto n = m_numStickersEdge;
+	auto index = [&](unsigned int x, unsigned int y) { return Index(face, x, y); };
+
+	for (unsigned int i = 0; i < n / 2; i++) {
+		for (unsigned int j = i; j < n - i - 1; j++) {
+			auto second = clockwise ? index(n - i - 1, j) : index(i, n - j - 1);
+			auto fourth = clockwise ? index(i, n - j - 1) : index(n - i - 1, j);
+			m_cycles.push_back({ { index(j, i), second, index(n - j - 1, n - i - 1), fourth } });
+		}
+	}
+}
+
+void MoveTable::AddMoveCycles(const MoveDescription& move)
+{
+	if (move.turnsFace) {
+		AddFaceCycles(move.face, move.faceClockwise);
+	}
+
+	for (auto k = 0u; k < m_numStickersEdge; k++) {
+		Cycle cycle;
+
+		for (auto j = 0u; j < 4u; j++) {
+			auto& line = move.ring[j];
+			cycle.stickers[j] = Index(line.face, line.x + k * line.dx, line.y + k * line.dy);
+		}
+		m_cycles.push_back(cycle);
+	}
+}
+
+void MoveTable::BuildShuffles()
+{
+	auto numStickers = 6u * m_numStickersEdge * m_numStickersEdge;
+	auto numMoves = m_offsets.size() - 1;
+	m_shuffles.reserve(numMoves);
+
+	for (size_t move = 0; move < numMoves; move++) {
+		uint8_t source[ShuffleKernel::NUM_BYTES];
+
+		for (auto i = 0u; i < numStickers; i++) {
+			source[i] = static_cast<uint8_t>(i);
+		}
+		for (auto c = m_offsets[move]; c < m_offsets[move + 1]; c++) {
+			auto& s = m_cycles[c].stickers;
+			source[s[0]] = static_cast<uint8_t>(s[1]);
+			source[s[1]] = static_cast<uint8_t>(s[2]);
+			source[s[2]] = static_cast<uint8_t>(s[3]);
+			source[s[3]] = static_cast<uint8_t>(s[0]);
+		}
+		m_shuffles.emplace_back(source, numStickers);
+	}
+}
+
+std::shared_ptr<const MoveTable> MoveTable::ForCubeLevel(unsigned int numStickersEdge)
+{
+	static std::mutex cacheMutex;
+	static std::map<unsigned int, std::weak_ptr<const MoveTable>> cache;
+
+	std::lock_guard<std::mutex> lock(cacheMutex);
+
+	auto& cached = cache[numStickersEdge];
+	auto table = cached.lock();
+
+	if (!table) {
+		table.reset(new MoveTable(numStickersEdge));
+		cached = table;
+	}
+	return table;
+}
+
+void MoveTable::ApplyRing(StickerBuffer& stickers, const MoveDescription& move) const
+{
+	// Lines stay straight under any face turn, so each one is resolved into a start and a stride
+	uint8_t* line[4];
+	ptrdiff_t stride[4];
+
+	for (auto j = 0u; j < 4u; j++) {
+		auto& l = move.ring[j];
+		auto start = stickers.Index(l.face, l.x, l.y);
+		auto next = stickers.Index(l.face, l.x + l.dx, l.y + l.dy);
+
+		line[j] = stickers.Data() + start;
+		stride[j] = static_cast<ptrdiff_t>(next) - static_cast<ptrdiff_t>(start);
+	}
+
+	for (auto k = 0u; k < m_numStickersEdge; k++) {
+		auto tmp = *line[0];
+		*line[0] = *line[1];
+		*line[1] = *line[2];
+		*line[2] = *line[3];
+		*line[3] = tmp;
+
+		line[0] += stride[0];
+		line[1] += stride[1];
+		line[2] += stride[2];
+		line[3] += stride[3];
+	}
+}
+
+void MoveTable::Apply(StickerBuffer& stickers, Axis axis, unsigned int layer, bool clockwise) const
+{
+	if (!m_shuffles.empty()) {
+		ShuffleKernel::Apply(stickers.Data(), m_shuffles[MoveIndex(axis, layer, clockwise)]);
+		return;
+	}
+
+	if (m_offsets.empty()) {
+		auto move = Describe(axis, layer, clockwise);
+		ApplyRing(stickers, move);
+
+		if (move.turnsFace) {
+			stickers.TurnFace(move.face, move.faceClockwise);
+		}
+		return;
+	}
+
+	auto move = MoveIndex(axis, layer, clockwise);
+	auto data = stickers.Data();
+	auto cycle = m_cycles.data() + m_offsets[move];
+	auto end = m_cycles.data() + m_offsets[move + 1];
+
+	for (; cycle != end; ++cycle) {
+		auto& s = cycle->stickers;
+		auto tmp = data[s[0]];
+		data[s[0]] = data[s[1]];
+		data[s[1]] = data[s[2]];
+		data[s[2]] = data[s[3]];
+		data[s[3]] = tmp;
+	}
+}
\ No newline at end of file
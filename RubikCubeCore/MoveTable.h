@@ -0,0 +1,162 @@
+#ifndef MOVE_TABLE_H
+#define MOVE_TABLE_H
+
+#include "ShuffleKernel.h"
+#include "StickerBuffer.h"
+
+#include <memory>
+#include <vector>
+#include <cstdint>
+
+// Precomputed sticker permutations of all moves for one cube's level
+// Every move (axis, layer, direction) of a small cube is stored as a list of 4-cycles of sticker indices,
+// so performing a move is one tight loop over the table without any branching
+// Cubes up to 3x3x3 perform every move as a single SIMD byte shuffle instead
+// Bigger cubes turn outer faces lazily through orientation tags of StickerBuffer
+// and shift only the ring of 4N stickers
+// Tables are immutable and shared between all cubes of the same level
+class MoveTable final {
+public:
+
+	enum Axis {
+		X_AXIS = 0,
+		Y_AXIS,
+		Z_AXIS,
+		NUM_AXES
+	};
+
+	typedef uint32_t StickerIndex;
+
+	// One move of the cube
+	struct Move {
+		Axis axis;
+		unsigned int layer;
+		bool clockwise;
+	};
+
+	// Largest cube's level which uses precomputed cycles, bigger cubes use face orientation tags
+	static constexpr unsigned int MAX_CYCLE_TABLE_STICKERS_EDGE = 7u;
+
+	// Line of stickers on one face as seen on the cube, starts at [x, y] and goes in direction [dx, dy]
+	struct Line {
+		unsigned int face;
+		unsigned int x;
+		unsigned int y;
+		int dx;
+		int dy;
+	};
+
+	// Sticker lines shifted by the move, colors are moved from ring[i + 1] into ring[i]
+	// and the whole face is turned if an outer layer is rotated
+	struct MoveDescription {
+		Line ring[4];
+		bool turnsFace;
+		unsigned int face;
+		bool faceClockwise;
+	};
+
+private:
+
+	// Indices of stickers in one cycle, sticker colors are moved from cycle[i + 1] into cycle[i]
+	struct Cycle {
+		StickerIndex stickers[4];
+	};
+
+	unsigned int m_numStickersEdge;
+
+	// Cycles of the move are stored in range <m_offsets[move], m_offsets[move + 1])
+	std::vector<uint32_t> m_offsets;
+	std::vector<Cycle> m_cycles;
+
+	// Whole-cube shuffles indexed by move, empty if the cube does not fit into the kernel
+	std::vector<ShuffleKernel::Permutation> m_shuffles;
+
+	explicit MoveTable(unsigned int numStickersEdge);
+
+	unsigned int MoveIndex(Axis axis, unsigned int layer, bool clockwise) const
+		{ return (axis * m_numStickersEdge + layer) * 2u + (clockwise ? 1u : 0u); }
+
+	// Same layout as StickerBuffer with no face turned
+	StickerIndex Index(unsigned int face, unsigned int x, unsigned int y) const
+		{ return static_cast<StickerIndex>((face * m_numStickersEdge + x) * m_numStickersEdge + y); }
+
+	void AddFaceCycles(unsigned int face, bool clockwise);
+	void AddMoveCycles(const MoveDescription& move);
+	void BuildShuffles();
+
+	// Shift ring stickers of big cubes, lines are resolved through face orientation tags
+	void ApplyRing(StickerBuffer& stickers, const MoveDescription& move) const;
+
+public:
+
+	MoveTable(const MoveTable&) = delete;
+	MoveTable& operator=(const MoveTable&) = delete;
+
+	// Get the table for given cube's level, table is built on first request
+	// and shared as long as somebody holds it
+	static std::shared_ptr<const MoveTable> ForCubeLevel(unsigned int numStickersEdge);
+
+	unsigned int NumStickersEdge() const { return m_numStickersEdge; }
+
+	// Lines and face touched by the move, independent of the sticker layout
+	MoveDescription Describe(Axis axis, unsigned int layer, bool clockwise) const
+		{ return Describe(m_numStickersEdge, axis, layer, clockwise); }
+
+	// Same as above for any cube's level, usable in constant expressions
+	static constexpr MoveDescription Describe(unsigned int n, Axis axis, unsigned int layer, bool clockwise)
+	{
+		auto i = layer;
+		MoveDescription move{};
+
+		switch (axis) {
+		case X_AXIS: {
+			// Same row on all faces around X axis
+			Line top = { StickerBuffer::TOP, i, 0, 0, 1 };
+			Line back = { StickerBuffer::BACK, i, 0, 0, 1 };
+			Line bottom = { StickerBuffer::BOTTOM, i, 0, 0, 1 };
+			Line front = { StickerBuffer::FRONT, i, 0, 0, 1 };
+			move.ring[0] = top;
+			move.ring[1] = clockwise ? back : front;
+			move.ring[2] = bottom;
+			move.ring[3] = clockwise ? front : back;
+			move.face = (i == 0) ? StickerBuffer::LEFT : StickerBuffer::RIGHT;
+			break;
+		}
+		case Y_AXIS: {
+			Line front = { StickerBuffer::FRONT, 0, n - i - 1, 1, 0 };
+			Line left = { StickerBuffer::LEFT, i, 0, 0, 1 };
+			Line back = { StickerBuffer::BACK, n - 1, i, -1, 0 };
+			Line right = { StickerBuffer::RIGHT, n - i - 1, n - 1, 0, -1 };
+			move.ring[0] = front;
+			move.ring[1] = clockwise ? left : right;
+			move.ring[2] = back;
+			move.ring[3] = clockwise ? right : left;
+			move.face = (i == 0) ? StickerBuffer::BOTTOM : StickerBuffer::TOP;
+			break;
+		}
+		default: {
+			Line top = { StickerBuffer::TOP, 0, i, 1, 0 };
+			Line right = { StickerBuffer::RIGHT, 0, i, 1, 0 };
+			Line bottom = { StickerBuffer::BOTTOM, n - 1, n - i - 1, -1, 0 };
+			Line left = { StickerBuffer::LEFT, 0, i, 1, 0 };
+			move.ring[0] = top;
+			move.ring[1] = clockwise ? right : left;
+			move.ring[2] = bottom;
+			move.ring[3] = clockwise ? left : right;
+			move.face = (i == 0) ? StickerBuffer::BACK : StickerBuffer::FRONT;
+			break;
+		}
+		}
+
+		// Face at the beginning of the axis is seen from the other side
+		move.turnsFace = (i == 0 || i == n - 1);
+		move.faceClockwise = (i == 0) ? !clockwise : clockwise;
+
+		return move;
+	}
+
+	// Perform the move on stickers of cube with the same level as this table
+	void Apply(StickerBuffer& stickers, Axis axis, unsigned int layer, bool clockwise) const;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,236 @@
+#include "PackedStickerStorage.h"
+#include "StickerBuffer.h"
+
+#include <algorithm>
+#include <cstring>
+
+// Taken by reference in std::min
+constexpr unsigned int PackedStickerStorage::STICKERS_PER_WORD;
+
+PackedStickerStorage::PackedStickerStorage(unsigned int numStickersEdge)
+	: m_moveTable(MoveTable::ForCubeLevel(numStickersEdge)),
+	m_numStickersEdge(numStickersEdge),
+	m_wordsPerRow((numStickersEdge + STICKERS_PER_WORD - 1) / STICKERS_PER_WORD)
+{
+	m_words.resize(StickerBuffer::NUM_FACES * numStickersEdge * m_wordsPerRow);
+	std::memset(m_faceTurns, 0, sizeof(m_faceTurns));
+}
+
+PackedStickerStorage::PhysicalLine PackedStickerStorage::Resolve(const MoveTable::Line& line) const
+{
+	auto last = m_numStickersEdge - 1;
+	auto turns = m_faceTurns[line.face];
+
+	auto x = line.x;
+	auto y = line.y;
+	StickerBuffer::ResolveFaceTurns(turns, last, x, y);
+
+	unsigned int nextX = line.x + line.dx;
+	unsigned int nextY = line.y + line.dy;
+	StickerBuffer::ResolveFaceTurns(turns, last, nextX, nextY);
+
+	return{ line.face, x, y,
+		static_cast<int>(nextX) - static_cast<int>(x),
+		static_cast<int>(nextY) - static_cast<int>(y) };
+}
+
+void PackedStickerStorage::CycleRows(const PhysicalLine* lines)
+{
+	uint64_t* rows[4];
+
+	for (auto j = 0u; j < 4u; j++) {
+		rows[j] = Row(lines[j].face, lines[j].x);
+	}
+	for (size_t w = 0; w < m_wordsPerRow; w++) {
+		auto tmp = rows[0][w];
+		rows[0][w] = rows[1][w];
+		rows[1][w] = rows[2][w];
+		rows[2][w] = rows[3][w];
+		rows[3][w] = tmp;
+	}
+}
+
+void PackedStickerStorage::CycleStickers(const PhysicalLine* lines)
+{
+	// Position of one sticker inside the packed words, walking along the line
+	struct Cursor {
+		uint64_t* word;
+		unsigned int shift;
+		ptrdiff_t wordStep;
+		int dy;
+
+		uint8_t Get() const { return static_cast<uint8_t>((*word >> shift) & STICKER_MASK); }
+		void Set(uint8_t color) { *word = (*word & ~(STICKER_MASK << shift)) | (static_cast<uint64_t>(color) << shift); }
+
+		void Next()
+		{
+			if (dy > 0) {
+				shift += BITS_PER_STICKER;
+				if (shift == STICKERS_PER_WORD * BITS_PER_STICKER) {
+					shift = 0;
+					word++;
+				}
+			}
+			else if (dy < 0) {
+				if (shift == 0) {
+					shift = STICKERS_PER_WORD * BITS_PER_STICKER;
+					word--;
+				}
+				shift -= BITS_PER_STICKER;
+			}
+			else {
+				word += wordStep;
+			}
+		}
+	};
+
+	Cursor cursors[4];
+
+	for (auto j = 0u; j < 4u; j++) {
+		auto& l = lines[j];
+		cursors[j].word = Row(l.face, l.x) + l.y / STICKERS_PER_WORD;
+		cursors[j].shift = (l.y % STICKERS_PER_WORD) * BITS_PER_STICKER;
+		cursors[j].wordStep = l.dx * static_cast<ptrdiff_t>(m_wordsPerRow);
+		cursors[j].dy = l.dy;
+	}
+
+	// Each line is walked on its own, so the direction branch is the same for the whole loop
+	auto n = m_numStickersEdge;
+	m_lineBuffer.resize(4u * n);
+
+	for (auto j = 0u; j < 4u; j++) {
+		auto cursor = cursors[(j + 1) % 4];
+		auto buffer = m_lineBuffer.data() + j * n;
+
+		for (auto k = 0u; k < n; k++, cursor.Next()) {
+			buffer[k] = cursor.Get();
+		}
+	}
+	for (auto j = 0u; j < 4u; j++) {
+		auto cursor = cursors[j];
+		auto buffer = m_lineBuffer.data() + j * n;
+
+		for (auto k = 0u; k < n; k++, cursor.Next()) {
+			cursor.Set(buffer[k]);
+		}
+	}
+}
+
+uint8_t PackedStickerStorage::Get(unsigned int face, unsigned int x, unsigned int y) const
+{
+	StickerBuffer::ResolveFaceTurns(m_faceTurns[face], m_numStickersEdge - 1, x, y);
+	return GetPhysical(face, x, y);
+}
+
+void PackedStickerStorage::FillFace(unsigned int face, uint8_t color)
+{
+	uint64_t pattern = 0;
+
+	for (auto i = 0u; i < STICKERS_PER_WORD; i++) {
+		pattern |= static_cast<uint64_t>(color) << (i * BITS_PER_STICKER);
+	}
+
+	// Padding of the last word in the row stays zero
+	auto lastWordStickers = m_numStickersEdge - (m_wordsPerRow - 1) * STICKERS_PER_WORD;
+	auto lastWordMask = (uint64_t(1) << (lastWordStickers * BITS_PER_STICKER)) - 1;
+
+	for (auto x = 0u; x < m_numStickersEdge; x++) {
+		auto row = Row(face, x);
+
+		for (size_t w = 0; w < m_wordsPerRow; w++) {
+			row[w] = pattern;
+		}
+		row[m_wordsPerRow - 1] &= lastWordMask;
+	}
+	m_faceTurns[face] = 0;
+}
+
+void PackedStickerStorage::Rotate(MoveTable::Axis axis, unsigned int layer, bool clockwise)
+{
+	auto move = m_moveTable->Describe(axis, layer, clockwise);
+	PhysicalLine lines[4];
+	bool wholeRows = true;
+
+	for (auto j = 0u; j < 4u; j++) {
+		lines[j] = Resolve(move.ring[j]);
+		wholeRows = wholeRows && lines[j].dx == 0 && lines[j].dy == lines[0].dy;
+	}
+
+	// Rows going in the same direction start at the same end, so k-th stickers share their column
+	if (wholeRows) {
+		CycleRows(lines);
+	}
+	else {
+		CycleStickers(lines);
+	}
+
+	if (move.turnsFace) {
+		m_faceTurns[move.face] = (m_faceTurns[move.face] + (move.faceClockwise ? 1u : 3u)) & 3u;
+	}
+}
+
+void PackedStickerStorage::UnpackRow(unsigned int face, unsigned int x, uint8_t* stickers) const
+{
+	auto row = Row(face, x);
+
+	for (auto y = 0u; y < m_numStickersEdge; y += STICKERS_PER_WORD) {
+		auto word = *row++;
+		auto count = std::min(STICKERS_PER_WORD, m_numStickersEdge - y);
+
+		for (auto i = 0u; i < count; i++, word >>= BITS_PER_STICKER) {
+			*stickers++ = static_cast<uint8_t>(word & STICKER_MASK);
+		}
+	}
+}
+
+void PackedStickerStorage::Read(uint8_t* stickers) const
+{
+	auto n = m_numStickersEdge;
+	std::vector<uint8_t> turnedFace;
+
+	for (auto face = 0u; face < StickerBuffer::NUM_FACES; face++, stickers += n * n) {
+		if (m_faceTurns[face] == 0) {
+			for (auto x = 0u; x < n; x++) {
+				UnpackRow(face, x, stickers + x * n);
+			}
+			continue;
+		}
+
+		// Lazily turned faces are unpacked as stored and then copied as seen
+		turnedFace.resize(n * n);
+
+		for (auto x = 0u; x < n; x++) {
+			UnpackRow(face, x, turnedFace.data() + x * n);
+		}
+		for (auto x = 0u; x < n; x++) {
+			for (auto y = 0u; y < n; y++) {
+				auto px = x;
+				auto py = y;
+				StickerBuffer::ResolveFaceTurns(m_faceTurns[face], n - 1, px, py);
+				stickers[x * n + y] = turnedFace[px * n + py];
+			}
+		}
+	}
+}
+
+void PackedStickerStorage::Write(const uint8_t* stickers)
+{
+	std::memset(m_faceTurns, 0, sizeof(m_faceTurns));
+
+	// Whole words are packed at once, unused bits of the last word of the row stay zero
+	for (auto face = 0u; face < StickerBuffer::NUM_FACES; face++) {
+		for (auto x = 0u; x < m_numStickersEdge; x++) {
+			auto row = Row(face, x);
+
+			for (auto y = 0u; y < m_numStickersEdge; y += STICKERS_PER_WORD) {
+				auto count = std::min(STICKERS_PER_WORD, m_numStickersEdge - y);
+				uint64_t word = 0;
+
+				for (auto i = 0u; i < count; i++) {
+					word |= static_cast<uint64_t>(*stickers++) << (i * BITS_PER_STICKER);
+				}
+				*row++ = word;
+			}
+		}
+	}
+}
\ No newline at end of file
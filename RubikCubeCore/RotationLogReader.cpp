@@ -0,0 +1,252 @@
+#include "RotationLogReader.h"
+#include "CubeNotation.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <cstring>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace {
+
+// Word with the high bit set in the lowest byte below 0x21 (space or control character) of the word,
+// bits of higher bytes are not reliable, bytes must be ASCII
+inline uint64_t SeparatorBytes(uint64_t word)
+{
+	const uint64_t ones = 0x0101010101010101ull;
+	return (word - ones * 0x21u) & ~word & (ones * 0x80u);
+}
+
+inline unsigned int CountTrailingZeros(uint64_t word)
+{
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanForward64(&index, word);
+	return static_cast<unsigned int>(index);
+#else
+	return static_cast<unsigned int>(__builtin_ctzll(word));
+#endif
+}
+
+}
+
+constexpr char RotationLogReader::NOTATION_HEADER[];
+
+RotationLogReader::RotationLogReader(const std::string& filepath, unsigned int numStickersEdge)
+	: m_file(filepath, std::ifstream::in | std::ifstream::binary),
+	m_numStickersEdge(numStickersEdge),
+	m_chunk(new char[CHUNK_SIZE + sizeof(uint64_t)]()),
+	m_begin(0),
+	m_end(0),
+	m_endOfFile(false),
+	m_bytesRead(0),
+	m_lineNumber(1),
+	m_legacy(true)
+{
+	if (!m_file.good()) {
+		throw std::runtime_error("Unable to open savefile");
+	}
+	FillChunk();
+
+	// The header is a token of its own, its line break is counted as any other
+	auto headerSize = sizeof(NOTATION_HEADER) - 1u;
+
+	if (m_end >= headerSize && std::memcmp(m_chunk.get(), NOTATION_HEADER, headerSize) == 0
+		&& (m_end == headerSize || IsSpace(m_chunk[headerSize]))) {
+		m_begin = headerSize;
+		m_legacy = false;
+	}
+}
+
+bool RotationLogReader::FillChunk()
+{
+	if (m_endOfFile) {
+		return false;
+	}
+	auto remaining = m_end - m_begin;
+
+	if (remaining == CHUNK_SIZE) {
+		throw std::runtime_error("Line " + std::to_string(m_lineNumber) + ": rotation is too long");
+	}
+	std::memmove(m_chunk.get(), m_chunk.get() + m_begin, remaining);
+	m_begin = 0;
+	m_end = remaining;
+
+	m_file.read(m_chunk.get() + m_end, CHUNK_SIZE - m_end);
+	auto numRead = static_cast<size_t>(m_file.gcount());
+
+	if (!m_file.good()) {
+		m_endOfFile = true;
+	}
+	m_end += numRead;
+	m_bytesRead += numRead;
+	return numRead > 0;
+}
+
+bool RotationLogReader::ParseTokensFast(size_t limit, std::vector<MoveTable::Move>& moves, size_t& numMoves)
+{
+	auto chunk = m_chunk.get();
+	auto n = m_numStickersEdge;
+
+	// A token takes at least two bytes together with the space behind it and gives at most two moves
+	if (moves.size() < numMoves + (limit - m_begin) + 1u) {
+		moves.resize(numMoves + (limit - m_begin) + 1u);
+	}
+	auto move = moves.data() + numMoves;
+	size_t numLines = 0;
+	auto i = m_begin;
+
+	while (i < limit) {
+		// The chunk is padded, so the word may reach behind the limit
+		uint64_t word;
+		std::memcpy(&word, chunk + i, sizeof(word));
+		auto separators = SeparatorBytes(word);
+
+		if (separators & 0x80u) {
+			auto c = static_cast<unsigned char>(word);
+
+			if (!IsSpace(c)) {
+				break;
+			}
+			numLines += c == '\n';
+			i++;
+			continue;
+		}
+
+		// Tokens of 8 and more bytes are left to CubeNotation
+		if (separators == 0) {
+			break;
+		}
+		auto length = static_cast<unsigned int>(CountTrailingZeros(separators) / 8u);
+		auto& letter = CubeNotation::LETTERS[static_cast<unsigned char>(word)];
+		auto second = static_cast<unsigned char>(word >> 8);
+		auto separator = static_cast<unsigned char>(word >> (8u * length));
+		bool valid = IsSpace(separator);
+
+		if (letter.kind == CubeNotation::INDEXED_LAYER) {
+			// X12, X.12
+			unsigned int dot = length > 1u && second == '.';
+			unsigned int index = 0;
+
+			for (auto k = 1u + dot; k < length; k++) {
+				auto digit = static_cast<unsigned int>(static_cast<unsigned char>(word >> (8u * k))) - '0';
+				valid &= digit <= 9u;
+				index = index * 10u + digit;
+			}
+			valid &= (length > 1u + dot) & (index < n);
+			*move++ = { letter.axis, index, (dot == 0) == letter.clockwise };
+		}
+		else {
+			// R, R', R., R2, R2', M on 3x3x3, anything else is left to CubeNotation
+			unsigned int half = length > 1u && second == '2';
+			auto suffix = static_cast<unsigned char>(word >> (8u * (1u + half)));
+			unsigned int inverted = length > 1u + half && (suffix == '\'' || suffix == '.');
+
+			// Face letters of legacy logs turn the other way, they are left to CubeNotation
+			valid &= (length == 1u + half + inverted) & !m_legacy
+				& ((letter.kind == CubeNotation::OUTER_LAYER) | ((letter.kind == CubeNotation::MIDDLE_LAYERS) & (n == 3u)));
+
+			auto layer = letter.kind == CubeNotation::MIDDLE_LAYERS ? 1u : (letter.fromLastLayer ? n - 1u : 0u);
+			MoveTable::Move parsed = { letter.axis, layer, (inverted == 0) == letter.clockwise };
+			*move = parsed;
+			move[half] = parsed;
+			move += 1u + half;
+		}
+
+		if (!valid) {
+			// The token is parsed again by CubeNotation, which reports the error if it is invalid
+			break;
+		}
+		numMoves = move - moves.data();
+
+		// The separator behind the token is consumed right away, only further ones take the branch above
+		numLines += separator == '\n';
+		i += length + 1u;
+	}
+
+	m_begin = i;
+	m_lineNumber += numLines;
+	return i >= limit;
+}
+
+bool RotationLogReader::ParseNextToken(std::vector<MoveTable::Move>& moves, size_t& numMoves)
+{
+	auto chunk = m_chunk.get();
+
+	while (m_begin < m_end && IsSpace(chunk[m_begin])) {
+		m_lineNumber += chunk[m_begin] == '\n';
+		m_begin++;
+	}
+
+	auto tokenEnd = m_begin;
+
+	while (tokenEnd < m_end && !IsSpace(chunk[tokenEnd])) {
+		tokenEnd++;
+	}
+
+	// The token may continue in the next chunk
+	if (tokenEnd == m_end) {
+		return false;
+	}
+	ParseToken(tokenEnd, moves, numMoves);
+	return true;
+}
+
+void RotationLogReader::ParseToken(size_t tokenEnd, std::vector<MoveTable::Move>& moves, size_t& numMoves)
+{
+	auto chunk = m_chunk.get();
+	m_tokenMoves.clear();
+
+	try {
+		if (m_legacy) {
+			CubeNotation::ParseLegacyToken(chunk + m_begin, chunk + tokenEnd, m_numStickersEdge, m_tokenMoves);
+		}
+		else {
+			CubeNotation::ParseToken(chunk + m_begin, chunk + tokenEnd, m_numStickersEdge, m_tokenMoves);
+		}
+	}
+	catch (const std::exception& ex) {
+		throw std::runtime_error("Line " + std::to_string(m_lineNumber) + ": " + ex.what());
+	}
+
+	if (moves.size() < numMoves + m_tokenMoves.size()) {
+		moves.resize(numMoves + m_tokenMoves.size());
+	}
+	std::copy(m_tokenMoves.begin(), m_tokenMoves.end(), moves.begin() + numMoves);
+	numMoves += m_tokenMoves.size();
+	m_begin = tokenEnd;
+}
+
+bool RotationLogReader::ReadMoves(std::vector<MoveTable::Move>& moves, size_t maxMoves)
+{
+	// Moves are written behind numMoves, the vector only grows until the end
+	size_t numMoves = 0;
+	moves.clear();
+
+	while (numMoves < maxMoves) {
+		// The fast path takes only whole tokens, so its range ends behind a space
+		auto limit = std::min(m_end, m_begin + 2u * (maxMoves - numMoves));
+
+		while (limit > m_begin && !IsSpace(m_chunk[limit - 1])) {
+			limit--;
+		}
+		if (limit > m_begin && ParseTokensFast(limit, moves, numMoves)) {
+			continue;
+		}
+
+		// The fast path stopped at an unusual or invalid token, errors are reported with the line
+		if (ParseNextToken(moves, numMoves)) {
+			continue;
+		}
+		if (!FillChunk()) {
+			// The last token of the file is not followed by a space
+			if (m_begin < m_end) {
+				ParseToken(m_end, moves, numMoves);
+			}
+			break;
+		}
+	}
+	moves.resize(numMoves);
+	return numMoves > 0;
+}
\ No newline at end of file
@@ -0,0 +1,79 @@
+#ifndef ROTATION_LOG_READER_H
+#define ROTATION_LOG_READER_H
+
+#include "MoveTable.h"
+
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Reader of rotation logs (tokens of CubeNotation separated by spaces) of any size
+// The file is read in big chunks and tokens are parsed in place, so memory does not grow with the file
+// and no string is allocated per rotation
+// Logs start with NOTATION_HEADER, logs saved by older versions have no header and are read
+// with CubeNotation::ParseLegacyToken, whose letters R U F S turn the other way
+class RotationLogReader final {
+public:
+
+	// First line of logs in the current notation
+	static constexpr char NOTATION_HEADER[] = "#notation 2";
+
+private:
+
+	static constexpr size_t CHUNK_SIZE = 1u << 20;
+
+	std::ifstream m_file;
+	unsigned int m_numStickersEdge;
+	// CHUNK_SIZE bytes followed by padding of one word
+	std::unique_ptr<char[]> m_chunk;
+
+	// Unparsed bytes of the chunk are [m_begin, m_end)
+	size_t m_begin;
+	size_t m_end;
+	bool m_endOfFile;
+
+	uint64_t m_bytesRead;
+	size_t m_lineNumber;
+	bool m_legacy;
+
+	// Moves of the token parsed by CubeNotation
+	std::vector<MoveTable::Move> m_tokenMoves;
+
+	static bool IsSpace(char c) { return c == ' ' || c == '\n' || c == '\r' || c == '\t'; }
+
+	// Move unparsed bytes to the front and read more behind them, false if nothing was read
+	bool FillChunk();
+
+	// Parsers write moves behind numMoves and advance it, moves grows only when there is no room
+
+	// Parse tokens of [m_begin, limit) of the usual short forms, limit follows a space
+	// Returns false if it stopped in front of a token which needs CubeNotation
+	bool ParseTokensFast(size_t limit, std::vector<MoveTable::Move>& moves, size_t& numMoves);
+
+	// Parse the next token with CubeNotation, false if no whole token is left in the chunk
+	bool ParseNextToken(std::vector<MoveTable::Move>& moves, size_t& numMoves);
+	void ParseToken(size_t tokenEnd, std::vector<MoveTable::Move>& moves, size_t& numMoves);
+
+public:
+
+	// Rotations are parsed for the cube of given level
+	RotationLogReader(const std::string& filepath, unsigned int numStickersEdge);
+
+	RotationLogReader(const RotationLogReader&) = delete;
+	RotationLogReader& operator=(const RotationLogReader&) = delete;
+
+	// Replace content of moves with next moves, false if there are no more moves
+	// Reading stops once there are maxMoves moves, a token with more moves (R2, 3Rw, x) is never split
+	// Throws an exception with the line number if some rotation is invalid
+	bool ReadMoves(std::vector<MoveTable::Move>& moves, size_t maxMoves);
+
+	uint64_t BytesRead() const { return m_bytesRead; }
+
+	// The log has no notation header, so it is read in the notation of older versions
+	bool IsLegacy() const { return m_legacy; }
+};
+
+#endif
\ No newline at end of file
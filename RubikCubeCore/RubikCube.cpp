@@ -0,0 +1,480 @@
+#include "RubikCube.h"
+#include "ByteStickerStorage.h"
+#include "CubeSnapshotFormat.h"
+#include "FixedStickerStorage.h"
+#include "PackedStickerStorage.h"
+#include "SparseStickerStorage.h"
+#include <fstream>
+#include <stdexcept>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+// Colors of faces of the solved cube in the order of FaceIndex
+const uint8_t SOLVED_FACE_COLORS[StickerBuffer::NUM_FACES] = {
+	StickerColor::WHITE,
+	StickerColor::YELLOW,
+	StickerColor::GREEN,
+	StickerColor::BLUE,
+	StickerColor::RED,
+	StickerColor::ORANGE
+};
+
+}
+
+RubikCube::RubikCube(unsigned int numStickersEdge)
+	: m_maxPendingMoves(DEFAULT_MAX_PENDING_MOVES)
+{
+	ResetAll();
+	NewCube(numStickersEdge);
+}
+
+RubikCube::RubikCube(const std::string& filepath)
+	: m_maxPendingMoves(DEFAULT_MAX_PENDING_MOVES)
+{
+	ResetAll();
+	LoadFromFile(filepath);
+}
+
+RubikCube::RubikCube(RubikCube&& r)
+	: m_maxPendingMoves(r.m_maxPendingMoves)
+{
+	*this = std::move(r);
+}
+
+RubikCube& RubikCube::operator=(RubikCube&& r)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	ResetAll();
+	m_stickers = std::move(r.m_stickers);
+	m_publishedStickers.reset();
+	m_hash = r.m_hash;
+	r.ResetAll();
+	Publish();
+	return *this;
+}
+
+void RubikCube::ResetAll()
+{
+	m_rotationType = NONE;
+	m_rotationTimer = 0.f;
+	m_rotationIndex = 0;
+	m_rotationClockwise = false;
+	m_pendingMoves.clear();
+}
+
+void RubikCube::StartRotation(const MoveTable::Move& move, float timer)
+{
+	m_rotationType = static_cast<RotationType>(move.axis);
+	m_rotationIndex = move.layer;
+	m_rotationClockwise = move.clockwise;
+	m_rotationTimer = timer;
+}
+
+void RubikCube::FinishRotations()
+{
+	if (m_rotationType != NONE) {
+		PerformRotation(static_cast<MoveTable::Axis>(m_rotationType), m_rotationIndex, m_rotationClockwise);
+	}
+	for (auto& move : m_pendingMoves) {
+		PerformRotation(move.axis, move.layer, move.clockwise);
+	}
+	ResetAll();
+}
+
+bool RubikCube::IsIdle() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_rotationType == NONE && m_pendingMoves.empty();
+}
+
+void RubikCube::SetMaxPendingMoves(size_t maxPendingMoves)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_maxPendingMoves = maxPendingMoves;
+}
+
+void RubikCube::FillFaceWithColor(FaceIndex face, StickerColor::Color c)
+{
+	m_stickers->FillFace(face, static_cast<uint8_t>(c));
+	m_publishedStickers.reset();
+}
+
+void RubikCube::Publish()
+{
+	// Stickers are copied only if they changed since the last snapshot
+	if (!m_publishedStickers) {
+		m_publishedStickers = m_stickers->Clone();
+	}
+	std::atomic_store(&m_snapshot, std::make_shared<const Snapshot>(m_publishedStickers, GetRotation(), m_hash));
+}
+
+void RubikCube::PerformRotation(MoveTable::Axis axis, unsigned int layer, bool clockwise)
+{
+	m_hash.Rotate(*m_stickers, axis, layer, clockwise);
+	m_stickers->Rotate(axis, layer, clockwise);
+	m_publishedStickers.reset();
+}
+
+void RubikCube::RequireDenseStickers(unsigned int numStickersEdge, const char* message)
+{
+	if (numStickersEdge > MAX_DENSE_STICKERS_PER_LINE) {
+		throw std::runtime_error(message);
+	}
+}
+
+std::unique_ptr<StickerStorage> RubikCube::CreateStorage(unsigned int numStickersEdge)
+{
+	// Common levels are specialized at compile time
+	switch (numStickersEdge) {
+	case 2: return std::make_unique<FixedStickerStorage<2>>();
+	case 3: return std::make_unique<FixedStickerStorage<3>>();
+	case 4: return std::make_unique<FixedStickerStorage<4>>();
+	case 5: return std::make_unique<FixedStickerStorage<5>>();
+	case 6: return std::make_unique<FixedStickerStorage<6>>();
+	case 7: return std::make_unique<FixedStickerStorage<7>>();
+	}
+
+	if (numStickersEdge > MAX_DENSE_STICKERS_PER_LINE) {
+		return std::make_unique<SparseStickerStorage>(numStickersEdge);
+	}
+	if (numStickersEdge >= MIN_PACKED_STICKERS_PER_LINE) {
+		return std::make_unique<PackedStickerStorage>(numStickersEdge);
+	}
+	return std::make_unique<ByteStickerStorage>(numStickersEdge);
+}
+
+void RubikCube::NewCube(unsigned int numStickersEdge)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	if (numStickersEdge == 0) {
+		throw std::runtime_error("Number of stickers per edge cannot be zero");
+	}
+	if (numStickersEdge > MAX_STICKERS_PER_LINE) {
+		throw std::runtime_error("Reached maximum number of stickers per line");
+	}
+	ResetAll();
+
+	m_stickers = CreateStorage(numStickersEdge);
+	for (auto face = 0u; face < StickerBuffer::NUM_FACES; face++) {
+		FillFaceWithColor(static_cast<FaceIndex>(face), static_cast<StickerColor::Color>(SOLVED_FACE_COLORS[face]));
+	}
+	m_hash.ResetSolved(numStickersEdge, SOLVED_FACE_COLORS);
+	Publish();
+}
+
+unsigned int RubikCube::ReadBinaryStickers(std::istream& file, std::vector<uint8_t>& stickers, ZobristHash::FaceHashes& faceHashes)
+{
+	uint8_t header[CubeSnapshotFormat::STICKERS_OFFSET];
+	file.read(reinterpret_cast<char*>(header), sizeof(header));
+
+	if (file.gcount() != sizeof(header) || LittleEndian::Read(header, 4u) != CubeSnapshotFormat::MAGIC) {
+		throw std::runtime_error("Save file is truncated");
+	}
+	if (LittleEndian::Read(header + 4, 2u) != CubeSnapshotFormat::VERSION) {
+		throw std::runtime_error("Unsupported save file version");
+	}
+	if (LittleEndian::Read(header + 6, 2u) != CubeSnapshotFormat::BYTE_LAYOUT) {
+		throw std::runtime_error("Unsupported sticker layout in save file");
+	}
+	auto numStickersPerEdge = static_cast<unsigned int>(LittleEndian::Read(header + 8, 4u));
+
+	if (numStickersPerEdge == 0 || numStickersPerEdge > MAX_DENSE_STICKERS_PER_LINE) {
+		throw std::runtime_error("Invalid number of stickers per edge in save file");
+	}
+
+	// Stickers are read at once straight into the buffer, nothing is parsed
+	stickers.resize(6u * static_cast<size_t>(numStickersPerEdge) * numStickersPerEdge);
+	file.read(reinterpret_cast<char*>(stickers.data()), stickers.size());
+
+	if (static_cast<size_t>(file.gcount()) != stickers.size()) {
+		throw std::runtime_error("Save file is truncated");
+	}
+
+	auto faceHashesData = header + CubeSnapshotFormat::HEADER_SIZE;
+	auto checksum = CubeSnapshotFormat::UpdateChecksum(CubeSnapshotFormat::CHECKSUM_SEED, faceHashesData,
+		CubeSnapshotFormat::STICKERS_OFFSET - CubeSnapshotFormat::HEADER_SIZE);
+	checksum = CubeSnapshotFormat::UpdateChecksum(checksum, stickers.data(), stickers.size());
+
+	if (checksum != LittleEndian::Read(header + 24, 8u)) {
+		throw std::runtime_error("Save file is corrupted");
+	}
+
+	// No branch per sticker, the loop is vectorized
+	uint8_t invalid = 0;
+
+	for (auto sticker : stickers) {
+		invalid |= sticker >= StickerColor::NUM_COLORS;
+	}
+	if (invalid) {
+		throw std::runtime_error("Invalid sticker color in save file");
+	}
+
+	uint64_t hash = 0;
+
+	for (auto face = 0u; face < StickerBuffer::NUM_FACES; face++) {
+		for (auto r = 0u; r < 4u; r++) {
+			faceHashes.values[face][r] = LittleEndian::Read(faceHashesData + 8u * (face * 4u + r), 8u);
+		}
+		hash ^= faceHashes.values[face][0];
+	}
+	if (hash != LittleEndian::Read(header + 16, 8u)) {
+		throw std::runtime_error("Save file is corrupted");
+	}
+	return numStickersPerEdge;
+}
+
+unsigned int RubikCube::ReadTextStickers(std::istream& file, std::vector<uint8_t>& stickers)
+{
+	unsigned int numStickersPerEdge = 0;
+	file >> numStickersPerEdge;
+
+	if (numStickersPerEdge == 0 || numStickersPerEdge > MAX_DENSE_STICKERS_PER_LINE) {
+		throw std::runtime_error("Invalid number of stickers per edge in save file");
+	}
+
+	// Sticker colors are stored face by face, row by row
+	stickers.resize(6u * static_cast<size_t>(numStickersPerEdge) * numStickersPerEdge);
+	unsigned int stickerColorIndex;
+
+	for (auto& sticker : stickers) {
+		file >> stickerColorIndex;
+
+		if (file.fail() || stickerColorIndex >= StickerColor::NUM_COLORS) {
+			throw std::runtime_error("Invalid sticker color in save file");
+		}
+		sticker = static_cast<uint8_t>(stickerColorIndex);
+	}
+	return numStickersPerEdge;
+}
+
+void RubikCube::LoadFromFile(const std::string& filepath)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	std::ifstream file(filepath, std::ifstream::in | std::ifstream::binary);
+
+	if (!file.good()) {
+		throw std::runtime_error("Unable to open save file");
+	}
+	uint8_t magic[4];
+	file.read(reinterpret_cast<char*>(magic), sizeof(magic));
+	auto binary = file.gcount() == sizeof(magic) && LittleEndian::Read(magic, sizeof(magic)) == CubeSnapshotFormat::MAGIC;
+
+	file.clear();
+	file.seekg(0);
+
+	std::vector<uint8_t> stickers;
+	unsigned int numStickersPerEdge;
+	ZobristHash hash;
+
+	// The binary file carries the hash, the text one is hashed from scratch
+	if (binary) {
+		ZobristHash::FaceHashes faceHashes;
+		numStickersPerEdge = ReadBinaryStickers(file, stickers, faceHashes);
+		hash.Restore(numStickersPerEdge, SOLVED_FACE_COLORS, faceHashes);
+	}
+	else {
+		numStickersPerEdge = ReadTextStickers(file, stickers);
+		hash.Reset(numStickersPerEdge, SOLVED_FACE_COLORS, stickers.data());
+	}
+	ResetAll();
+
+	auto storage = CreateStorage(numStickersPerEdge);
+	storage->Write(stickers.data());
+	m_stickers = std::move(storage);
+	m_publishedStickers.reset();
+	m_hash = hash;
+	Publish();
+}
+
+void RubikCube::SaveIntoFile(const std::string& filepath) const
+{
+	auto snapshot = GetSnapshot();
+	auto numStickers = snapshot->GetNumStickersPerEdge();
+	RequireDenseStickers(numStickers, "Cube is too big to be saved");
+
+	std::ofstream file(filepath, std::ofstream::out | std::ofstream::binary);
+
+	if (!file.good()) {
+		throw std::runtime_error("Unable to create file for saving");
+	}
+
+	// The whole file is built in memory and written at once
+	auto& storage = snapshot->GetStickers();
+	std::vector<uint8_t> data(CubeSnapshotFormat::STICKERS_OFFSET + storage.Size());
+	auto header = data.data();
+	auto& faceHashes = snapshot->GetFaceHashes();
+
+	for (auto face = 0u; face < StickerBuffer::NUM_FACES; face++) {
+		for (auto r = 0u; r < 4u; r++) {
+			LittleEndian::Write(header + CubeSnapshotFormat::HEADER_SIZE + 8u * (face * 4u + r), faceHashes.values[face][r], 8u);
+		}
+	}
+	storage.Read(data.data() + CubeSnapshotFormat::STICKERS_OFFSET);
+
+	LittleEndian::Write(header, CubeSnapshotFormat::MAGIC, 4u);
+	LittleEndian::Write(header + 4, CubeSnapshotFormat::VERSION, 2u);
+	LittleEndian::Write(header + 6, CubeSnapshotFormat::BYTE_LAYOUT, 2u);
+	LittleEndian::Write(header + 8, numStickers, 4u);
+	LittleEndian::Write(header + 16, snapshot->Hash(), 8u);
+	LittleEndian::Write(header + 24, CubeSnapshotFormat::UpdateChecksum(CubeSnapshotFormat::CHECKSUM_SEED,
+		data.data() + CubeSnapshotFormat::HEADER_SIZE, data.size() - CubeSnapshotFormat::HEADER_SIZE), 8u);
+
+	file.write(reinterpret_cast<const char*>(data.data()), data.size());
+	file.close();
+
+	if (file.fail()) {
+		throw std::runtime_error("Unable to write save file");
+	}
+}
+
+void RubikCube::ExportIntoTextFile(const std::string& filepath) const
+{
+	auto snapshot = GetSnapshot();
+	auto numStickers = snapshot->GetNumStickersPerEdge();
+	RequireDenseStickers(numStickers, "Cube is too big to be exported");
+
+	std::ofstream file(filepath, std::ofstream::out);
+
+	if (!file.good()) {
+		throw std::runtime_error("Unable to create file for saving");
+	}
+	file << numStickers << '\n';
+
+	// Lazily turned faces are materialized, so rows are written straight from the copy
+	auto& storage = snapshot->GetStickers();
+	std::vector<uint8_t> stickers(storage.Size());
+	storage.Read(stickers.data());
+	auto sticker = stickers.data();
+
+	// Colors are single digits, every row is formatted into one string
+	std::string row(2u * numStickers + 1u, ' ');
+	row.back() = '\n';
+
+	for (auto face = 0u; face < StickerBuffer::NUM_FACES; face++) {
+		for (auto x = 0u; x < numStickers; x++) {
+			for (auto y = 0u; y < numStickers; y++) {
+				row[2u * y] = static_cast<char>('0' + *sticker++);
+			}
+			file << row;
+		}
+		file << '\n';
+	}
+	file.close();
+}
+
+bool RubikCube::Rotate(RubikCube::RotationType rotationType, unsigned int rotationIndex, bool rotationClockwise)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	if (rotationIndex >= GetNumStickersPerEdge()) {
+		throw std::runtime_error("Rotation index is larger than number of stickers!");
+	}
+	if (rotationType == NONE) {
+		throw std::runtime_error("Unknown rotation type");
+	}
+	MoveTable::Move move = { static_cast<MoveTable::Axis>(rotationType), rotationIndex, rotationClockwise };
+
+	if (m_rotationType == NONE) {
+		StartRotation(move, 0.f);
+		Publish();
+	}
+	else if (m_pendingMoves.size() < m_maxPendingMoves) {
+		m_pendingMoves.push_back(move);
+	}
+	else {
+		return false;
+	}
+	return true;
+}
+
+void RubikCube::Update(float deltaTime)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	if (m_rotationType != NONE) {
+		m_rotationTimer += deltaTime;
+
+		if (m_rotationTimer >= ROTATION_TIME) {
+			PerformRotation(static_cast<MoveTable::Axis>(m_rotationType), m_rotationIndex, m_rotationClockwise);
+			m_rotationType = NONE;
+
+			// The next move continues with the time left over, so queued moves run back to back
+			if (!m_pendingMoves.empty()) {
+				StartRotation(m_pendingMoves.front(), m_rotationTimer - ROTATION_TIME);
+				m_pendingMoves.pop_front();
+			}
+		}
+		Publish();
+	}
+}
+
+void RubikCube::ApplyCompiledMoves(const CompiledMoves& moves)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	if (moves.NumStickersEdge() != GetNumStickersPerEdge()) {
+		throw std::runtime_error("Compiled moves do not fit the cube's level");
+	}
+	FinishRotations();
+
+	std::vector<uint8_t> source(m_stickers->Size());
+	std::vector<uint8_t> destination(m_stickers->Size());
+	m_stickers->Read(source.data());
+	moves.Apply(source.data(), destination.data());
+	m_stickers->Write(destination.data());
+	m_publishedStickers.reset();
+	m_hash.Reset(GetNumStickersPerEdge(), SOLVED_FACE_COLORS, destination.data());
+	Publish();
+}
+
+void RubikCube::ApplyMoves(const std::vector<MoveTable::Move>& moves)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	auto numStickersEdge = GetNumStickersPerEdge();
+
+	for (auto& move : moves) {
+		if (move.axis >= MoveTable::NUM_AXES || move.layer >= numStickersEdge) {
+			throw std::runtime_error("Move does not fit the cube's level");
+		}
+	}
+	FinishRotations();
+
+	auto rehash = numStickersEdge <= MAX_DENSE_STICKERS_PER_LINE
+		&& moves.size() >= static_cast<size_t>(MIN_REHASHED_MOVES_PER_STICKER) * numStickersEdge;
+
+	if (rehash) {
+		for (auto& move : moves) {
+			m_stickers->Rotate(move.axis, move.layer, move.clockwise);
+		}
+		std::vector<uint8_t> stickers(m_stickers->Size());
+		m_stickers->Read(stickers.data());
+		m_publishedStickers.reset();
+		m_hash.Reset(numStickersEdge, SOLVED_FACE_COLORS, stickers.data());
+	}
+	else {
+		for (auto& move : moves) {
+			PerformRotation(move.axis, move.layer, move.clockwise);
+		}
+	}
+	Publish();
+}
+
+unsigned int RubikCube::ReadCanonicalStickers(uint8_t* stickers) const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	RequireDenseStickers(GetNumStickersPerEdge(), "Cube is too big to be canonicalized");
+
+	if (!m_symmetry || m_symmetry->NumStickersEdge() != GetNumStickersPerEdge()) {
+		m_symmetry = CubeSymmetry::ForCubeLevel(GetNumStickersPerEdge());
+	}
+
+	std::vector<uint8_t> current(m_stickers->Size());
+	m_stickers->Read(current.data());
+	return m_symmetry->Canonicalize(current.data(), stickers);
+}
\ No newline at end of file
@@ -0,0 +1,241 @@
+#ifndef RUBIK_CUBE_H
+#define RUBIK_CUBE_H
+
+#include "CompiledMoves.h"
+#include "CubeSymmetry.h"
+#include "StickerBuffer.h"
+#include "StickerColor.h"
+#include "StickerStorage.h"
+#include "ZobristHash.h"
+#include <deque>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Rubik's cube model: stickers and the rotation being animated
+// It has no GL dependency, RubikCubeRenderer draws it
+class RubikCube final {
+public:
+
+	enum RotationType {
+		X_AXIS = MoveTable::X_AXIS,
+		Y_AXIS = MoveTable::Y_AXIS,
+		Z_AXIS = MoveTable::Z_AXIS,
+		NONE,
+	};
+
+	enum FaceIndex {
+		TOP = StickerBuffer::TOP,
+		BOTTOM = StickerBuffer::BOTTOM,
+		LEFT = StickerBuffer::LEFT,
+		RIGHT = StickerBuffer::RIGHT,
+		FRONT = StickerBuffer::FRONT,
+		BACK = StickerBuffer::BACK
+	};
+
+	// Rotation being animated
+	struct Rotation {
+		RotationType type;
+		unsigned int index;
+		bool clockwise;
+		// Part of the rotation already performed <0, 1>
+		float progress;
+	};
+
+	// Immutable state of the cube, a new one is published after every change
+	// Readers on other threads hold it instead of locking the cube
+	class Snapshot final {
+	private:
+
+		std::shared_ptr<const StickerStorage> m_stickers;
+		Rotation m_rotation;
+		uint64_t m_hash;
+		ZobristHash::FaceHashes m_faceHashes;
+
+	public:
+
+		Snapshot(const std::shared_ptr<const StickerStorage>& stickers, const Rotation& rotation, const ZobristHash& hash)
+			: m_stickers(stickers), m_rotation(rotation), m_hash(hash.Value()), m_faceHashes(hash.GetFaceHashes()) {}
+
+		unsigned int GetNumStickersPerEdge() const { return m_stickers->NumStickersEdge(); }
+
+		StickerColor::Color GetSticker(FaceIndex face, unsigned int x, unsigned int y) const
+			{ return static_cast<StickerColor::Color>(m_stickers->Get(face, x, y)); }
+
+		unsigned int GetStickerRunLength(FaceIndex face, unsigned int x, unsigned int y, unsigned int endY) const
+			{ return m_stickers->RunLength(face, x, y, 0, 1, endY - y); }
+
+		unsigned int GetEqualRows(FaceIndex face, unsigned int x, unsigned int endX) const
+			{ return m_stickers->EqualRows(face, x, endX); }
+
+		const Rotation& GetRotation() const { return m_rotation; }
+		uint64_t Hash() const { return m_hash; }
+		const ZobristHash::FaceHashes& GetFaceHashes() const { return m_faceHashes; }
+
+		const StickerStorage& GetStickers() const { return *m_stickers; }
+	};
+
+private:
+
+	// Budget of the biggest cube with all stickers stored: 6 MB of stickers, every move shifts 4000 stickers,
+	// see README for the memory/time budget per level
+	static constexpr unsigned int MAX_DENSE_STICKERS_PER_LINE = 1000u;
+
+	// Bigger cubes keep only stickers moved from the solved state, they can not be saved or loaded
+	static constexpr unsigned int MAX_STICKERS_PER_LINE = 1000000u;
+
+	// Cubes from this level up store stickers bit-packed (3 bits per sticker) to stay cache resident
+	static constexpr unsigned int MIN_PACKED_STICKERS_PER_LINE = 512u;
+	static constexpr float ROTATION_TIME = 1.f;
+
+	// ApplyMoves() with this many moves per sticker of the edge rehashes all stickers once at the end
+	// instead of updating the hash with every move
+	static constexpr unsigned int MIN_REHASHED_MOVES_PER_STICKER = 2u;
+
+	// Default number of moves waiting for the animation, enough for any pasted algorithm
+	static constexpr size_t DEFAULT_MAX_PENDING_MOVES = 256u;
+
+	std::unique_ptr<StickerStorage> m_stickers;
+
+	// Copy of m_stickers shared by snapshots, dropped whenever stickers change
+	std::shared_ptr<const StickerStorage> m_publishedStickers;
+
+	// Accessed only with std::atomic_load/atomic_store
+	std::shared_ptr<const Snapshot> m_snapshot;
+
+	// Hash of m_stickers, every change of stickers must go through it
+	ZobristHash m_hash;
+
+	// Symmetry tables of the cube's level, acquired on the first canonicalization
+	mutable std::shared_ptr<const CubeSymmetry> m_symmetry;
+
+	RotationType m_rotationType;
+	unsigned int m_rotationIndex;
+	bool m_rotationClockwise;
+	float m_rotationTimer;
+
+	// Moves animated one after another when the current rotation is finished
+	std::deque<MoveTable::Move> m_pendingMoves;
+	size_t m_maxPendingMoves;
+
+	mutable std::mutex m_mutex;
+
+	// Reset all rotation* values to "zero" and drop pending moves, do not destroy anything
+	void ResetAll();
+
+	// Start animating the move, the cube must not be rotating
+	void StartRotation(const MoveTable::Move& move, float timer);
+
+	// Perform the rotation being animated and all pending moves at once
+	void FinishRotations();
+
+	void FillFaceWithColor(FaceIndex face, StickerColor::Color c);
+
+	// Publish the current state for readers of GetSnapshot(), call it at the end of every change
+	void Publish();
+
+	// Perform the move on stickers and the hash
+	void PerformRotation(MoveTable::Axis axis, unsigned int layer, bool clockwise);
+
+	// Throw an exception if the cube is too big to have all its stickers in memory at once
+	static void RequireDenseStickers(unsigned int numStickersEdge, const char* message);
+
+	// Pick sticker storage suitable for given cube's level
+	static std::unique_ptr<StickerStorage> CreateStorage(unsigned int numStickersEdge);
+
+	// Read stickers of the binary save file and face hashes of its Zobrist hash, returns the cube's level
+	static unsigned int ReadBinaryStickers(std::istream& file, std::vector<uint8_t>& stickers, ZobristHash::FaceHashes& faceHashes);
+
+	// Read stickers of the text export, returns the cube's level
+	static unsigned int ReadTextStickers(std::istream& file, std::vector<uint8_t>& stickers);
+
+public:
+
+	// Number of stickers per edge = Cube's level
+	explicit RubikCube(unsigned int numStickersEdge = 3);
+	explicit RubikCube(const std::string& filepath);
+
+	RubikCube(RubikCube&& r);
+	RubikCube& operator=(RubikCube&& r);
+
+	RubikCube(const RubikCube&) = delete;
+	RubikCube& operator=(const RubikCube&) = delete;
+
+	// Number of stickers per edge = Cube's level
+	unsigned int GetNumStickersPerEdge() const { return m_stickers->NumStickersEdge(); }
+	bool IsRotating() const { return m_rotationType != NONE; }
+
+	// Number of moves waiting until the rotation being animated is finished
+	size_t GetNumPendingMoves() const { return m_pendingMoves.size(); }
+	size_t GetMaxPendingMoves() const { return m_maxPendingMoves; }
+
+	// No rotation is animated and no move waits, safe to call from any thread
+	bool IsIdle() const;
+
+	// Moves over this limit are rejected by Rotate(), zero rejects all moves while rotating
+	// The limit is kept when another cube is moved into this one
+	void SetMaxPendingMoves(size_t maxPendingMoves);
+
+	// Sticker on position [x, y] of the face as it is seen on the cube
+	// Lock GetMutex() or use GetSnapshot() while reading stickers from another thread
+	StickerColor::Color GetSticker(FaceIndex face, unsigned int x, unsigned int y) const
+		{ return static_cast<StickerColor::Color>(m_stickers->Get(face, x, y)); }
+
+	// Number of stickers with the same color from [x, y] on in the row x, at most endY - y
+	unsigned int GetStickerRunLength(FaceIndex face, unsigned int x, unsigned int y, unsigned int endY) const
+		{ return m_stickers->RunLength(face, x, y, 0, 1, endY - y); }
+
+	// Number of rows from the row x on known to be equal to the row x, at most endX - x
+	unsigned int GetEqualRows(FaceIndex face, unsigned int x, unsigned int endX) const
+		{ return m_stickers->EqualRows(face, x, endX); }
+
+	Rotation GetRotation() const
+		{ return{ m_rotationType, m_rotationIndex, m_rotationClockwise, m_rotationTimer / ROTATION_TIME }; }
+
+	std::mutex& GetMutex() const { return m_mutex; }
+
+	// Latest published state, it never waits for the cube's mutex
+	std::shared_ptr<const Snapshot> GetSnapshot() const { return std::atomic_load(&m_snapshot); }
+
+	// Zobrist hash of stickers, the rotation being animated is not included until it is finished
+	// Equal cubes of the same level have equal hashes
+	uint64_t Hash() const { return m_hash.Value(); }
+
+	// Write stickers of the representative of all cubes equal up to rotation or mirroring of the whole cube
+	// into GetNumStickersPerEdge()^2 * 6 bytes, see CubeSymmetry::Canonicalize() for color labels
+	// Returns the CubeSymmetry mapping the cube onto the representative
+	unsigned int ReadCanonicalStickers(uint8_t* stickers) const;
+
+	// Rotate one of the cube's faces, the move waits in the queue if the cube is rotating
+	// May throw an exception if rotationIndex is greater than GetNumStickersPerEdge()
+	// Return false if the queue of pending moves is full, true if rotation started or was queued
+	bool Rotate(RotationType rotationType, unsigned int rotationIndex, bool rotationClockwise);
+
+	void Update(float deltaTime);
+
+	// Perform the whole compiled sequence at once, the rotation being animated and pending moves are finished first
+	// Throws an exception if the sequence was compiled for another cube's level
+	void ApplyCompiledMoves(const CompiledMoves& moves);
+
+	// Perform the whole sequence at once move by move, under one lock and with one published snapshot
+	// The rotation being animated and pending moves are finished first
+	// Throws an exception if some move does not fit the cube's level, the cube is not changed then
+	void ApplyMoves(const std::vector<MoveTable::Move>& moves);
+
+	// Create new cube with given number of stickers per edge
+	void NewCube(unsigned int numStickersEdge = 3);
+
+	// Load the binary save file or the text export, the format is detected from the file
+	// Throws an exception if the file is invalid, the cube is not changed then
+	void LoadFromFile(const std::string& filepath);
+
+	// Both save the latest snapshot, the cube is not locked while writing the file
+	// The binary save file (see CubeSnapshotFormat) is the raw sticker buffer with a header
+	void SaveIntoFile(const std::string& filepath) const;
+	// Sticker colors as numbers in text, face by face, row by row
+	void ExportIntoTextFile(const std::string& filepath) const;
+};
+
+#endif
\ No newline at end of file
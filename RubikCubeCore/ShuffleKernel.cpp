@@ -0,0 +1,174 @@
+#include "ShuffleKernel.h"
+
+#include <cstring>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define SHUFFLE_KERNEL_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+// MSVC accepts all intrinsics in any function, GCC and Clang need per-function target
+#if defined(SHUFFLE_KERNEL_X86) && !defined(_MSC_VER)
+#define SHUFFLE_KERNEL_TARGET(isa) __attribute__((target(isa)))
+#else
+#define SHUFFLE_KERNEL_TARGET(isa)
+#endif
+
+namespace {
+
+	typedef void(*KernelFunction)(uint8_t*, const ShuffleKernel::Permutation&);
+
+	void ApplyScalar(uint8_t* stickers, const ShuffleKernel::Permutation& permutation)
+	{
+		uint8_t result[ShuffleKernel::NUM_BYTES];
+
+		for (size_t i = 0; i < ShuffleKernel::NUM_BYTES; i++) {
+			result[i] = stickers[permutation.source[i]];
+		}
+		std::memcpy(stickers, result, ShuffleKernel::NUM_BYTES);
+	}
+
+#ifdef SHUFFLE_KERNEL_X86
+
+	SHUFFLE_KERNEL_TARGET("ssse3")
+	void ApplySsse3(uint8_t* stickers, const ShuffleKernel::Permutation& permutation)
+	{
+		__m128i source[ShuffleKernel::NUM_LANES];
+		__m128i result[ShuffleKernel::NUM_LANES];
+
+		for (size_t s = 0; s < ShuffleKernel::NUM_LANES; s++) {
+			source[s] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(stickers + s * ShuffleKernel::LANE_BYTES));
+		}
+		for (size_t d = 0; d < ShuffleKernel::NUM_LANES; d++) {
+			result[d] = _mm_setzero_si128();
+
+			for (size_t s = 0; s < ShuffleKernel::NUM_LANES; s++) {
+				auto control = _mm_loadu_si128(reinterpret_cast<const __m128i*>(permutation.control[s][d]));
+				result[d] = _mm_or_si128(result[d], _mm_shuffle_epi8(source[s], control));
+			}
+		}
+		for (size_t d = 0; d < ShuffleKernel::NUM_LANES; d++) {
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(stickers + d * ShuffleKernel::LANE_BYTES), result[d]);
+		}
+	}
+
+	SHUFFLE_KERNEL_TARGET("avx2")
+	void ApplyAvx2(uint8_t* stickers, const ShuffleKernel::Permutation& permutation)
+	{
+		// vpshufb works within 128 bit lanes, so every source lane is broadcast
+		// and two destination lanes are computed at once
+		auto low = _mm256_setzero_si256();
+		auto high = _mm256_setzero_si256();
+
+		for (size_t s = 0; s < ShuffleKernel::NUM_LANES; s++) {
+			auto lane = _mm_loadu_si128(reinterpret_cast<const __m128i*>(stickers + s * ShuffleKernel::LANE_BYTES));
+			auto source = _mm256_broadcastsi128_si256(lane);
+			auto lowControl = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(permutation.control[s][0]));
+			auto highControl = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(permutation.control[s][2]));
+
+			low = _mm256_or_si256(low, _mm256_shuffle_epi8(source, lowControl));
+			high = _mm256_or_si256(high, _mm256_shuffle_epi8(source, highControl));
+		}
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(stickers), low);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(stickers + 2 * ShuffleKernel::LANE_BYTES), high);
+	}
+
+	SHUFFLE_KERNEL_TARGET("avx512f,avx512vbmi")
+	void ApplyAvx512Vbmi(uint8_t* stickers, const ShuffleKernel::Permutation& permutation)
+	{
+		auto source = _mm512_loadu_si512(stickers);
+		auto indices = _mm512_loadu_si512(permutation.source);
+		_mm512_storeu_si512(stickers, _mm512_permutexvar_epi8(indices, source));
+	}
+
+	struct CpuFeatures {
+		bool ssse3 = false;
+		bool avx2 = false;
+		bool avx512vbmi = false;
+
+		CpuFeatures()
+		{
+#ifdef _MSC_VER
+			int info[4];
+			__cpuid(info, 0);
+			auto maxLeaf = info[0];
+
+			__cpuid(info, 1);
+			ssse3 = (info[2] & (1 << 9)) != 0;
+			bool osxsave = (info[2] & (1 << 27)) != 0;
+
+			// AVX registers must be enabled by the OS as well
+			unsigned long long xcr0 = osxsave ? _xgetbv(0) : 0;
+			bool ymmEnabled = (xcr0 & 0x6) == 0x6;
+			bool zmmEnabled = (xcr0 & 0xe6) == 0xe6;
+
+			if (maxLeaf >= 7) {
+				__cpuidex(info, 7, 0);
+				avx2 = ymmEnabled && (info[1] & (1 << 5)) != 0;
+				avx512vbmi = zmmEnabled && (info[1] & (1 << 16)) != 0 && (info[2] & (1 << 1)) != 0;
+			}
+#else
+			__builtin_cpu_init();
+			ssse3 = __builtin_cpu_supports("ssse3") != 0;
+			avx2 = __builtin_cpu_supports("avx2") != 0;
+			avx512vbmi = __builtin_cpu_supports("avx512f") != 0 && __builtin_cpu_supports("avx512vbmi") != 0;
+#endif
+		}
+	};
+
+#endif
+
+	struct Kernel {
+		KernelFunction function;
+		const char* name;
+	};
+
+	const Kernel& SelectKernel()
+	{
+		static const Kernel kernel = []() -> Kernel {
+#ifdef SHUFFLE_KERNEL_X86
+			CpuFeatures features;
+
+			if (features.avx512vbmi) {
+				return { ApplyAvx512Vbmi, "AVX-512 VBMI" };
+			}
+			if (features.avx2) {
+				return { ApplyAvx2, "AVX2" };
+			}
+			if (features.ssse3) {
+				return { ApplySsse3, "SSSE3" };
+			}
+#endif
+			return { ApplyScalar, "scalar" };
+		}();
+
+		return kernel;
+	}
+}
+
+ShuffleKernel::Permutation::Permutation(const uint8_t* source, size_t numBytes)
+{
+	for (size_t i = 0; i < NUM_BYTES; i++) {
+		this->source[i] = (i < numBytes) ? source[i] : static_cast<uint8_t>(i);
+	}
+
+	std::memset(control, 0x80, sizeof(control));
+
+	for (size_t i = 0; i < NUM_BYTES; i++) {
+		auto from = this->source[i];
+		control[from / LANE_BYTES][i / LANE_BYTES][i % LANE_BYTES] = from % LANE_BYTES;
+	}
+}
+
+void ShuffleKernel::Apply(uint8_t* stickers, const Permutation& permutation)
+{
+	SelectKernel().function(stickers, permutation);
+}
+
+const char* ShuffleKernel::InstructionSet()
+{
+	return SelectKernel().name;
+}
\ No newline at end of file
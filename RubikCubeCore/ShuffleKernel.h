@@ -0,0 +1,41 @@
+#ifndef SHUFFLE_KERNEL_H
+#define SHUFFLE_KERNEL_H
+
+#include <cstdint>
+#include <cstddef>
+
+// Byte-shuffle kernel for cubes whose stickers fit into a single cache line (up to 3x3x3)
+// Any move is applied as one permutation of the whole 64 byte block,
+// the best available instruction set is picked at runtime (AVX-512 VBMI, AVX2, SSSE3 or scalar code)
+class ShuffleKernel final {
+public:
+
+	static constexpr size_t NUM_BYTES = 64u;
+	static constexpr size_t LANE_BYTES = 16u;
+	static constexpr size_t NUM_LANES = NUM_BYTES / LANE_BYTES;
+
+	// Precomputed shuffle of one move
+	struct Permutation {
+		// Byte i of the result is taken from byte source[i]
+		uint8_t source[NUM_BYTES];
+
+		// pshufb controls, control[s][d] picks bytes of destination lane d from source lane s,
+		// all other bytes are zeroed (high bit set)
+		uint8_t control[NUM_LANES][NUM_LANES][LANE_BYTES];
+
+		// Build from gather indices, indices beyond numBytes are left untouched
+		Permutation(const uint8_t* source, size_t numBytes);
+	};
+
+	ShuffleKernel() = delete;
+
+	static bool Fits(size_t numStickers) { return numStickers <= NUM_BYTES; }
+
+	// Stickers must be accessible as the whole 64 byte block (StickerBuffer is padded to cache line)
+	static void Apply(uint8_t* stickers, const Permutation& permutation);
+
+	// Name of the instruction set picked at runtime
+	static const char* InstructionSet();
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,284 @@
+#include "SparseStickerStorage.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+SparseStickerStorage::SparseStickerStorage(unsigned int numStickersEdge)
+	: m_numStickersEdge(numStickersEdge)
+{
+	if (numStickersEdge == 0) {
+		throw std::runtime_error("SparseStickerStorage: number of stickers per edge cannot be zero");
+	}
+	std::memset(m_faceTurns, 0, sizeof(m_faceTurns));
+
+	for (auto face = 0u; face < StickerBuffer::NUM_FACES; face++) {
+		FillFace(face, 0);
+	}
+}
+
+size_t SparseStickerStorage::Band(const std::vector<unsigned int>& borders, unsigned int v)
+{
+	return static_cast<size_t>(std::upper_bound(borders.begin(), borders.end(), v) - borders.begin()) - 1u;
+}
+
+void SparseStickerStorage::SplitRows(Face& face, unsigned int v)
+{
+	if (v == 0 || v >= m_numStickersEdge) {
+		return;
+	}
+	auto band = Band(face.rows, v);
+	if (face.rows[band] == v) {
+		return;
+	}
+
+	// The new band copies its row of cells into a new slot
+	auto slot = static_cast<unsigned int>(face.cells.size());
+	face.cells.push_back(face.cells[face.rowSlots[band]]);
+
+	face.rows.insert(face.rows.begin() + band + 1, v);
+	face.rowSlots.insert(face.rowSlots.begin() + band + 1, slot);
+}
+
+void SparseStickerStorage::SplitColumns(Face& face, unsigned int v)
+{
+	if (v == 0 || v >= m_numStickersEdge) {
+		return;
+	}
+	auto band = Band(face.columns, v);
+	if (face.columns[band] == v) {
+		return;
+	}
+
+	// Every row gets one cell behind its last one, the other cells stay in place
+	auto oldSlot = face.columnSlots[band];
+	auto slot = static_cast<unsigned int>(face.cells.front().size());
+
+	for (auto& row : face.cells) {
+		row.push_back(row[oldSlot]);
+	}
+	face.columns.insert(face.columns.begin() + band + 1, v);
+	face.columnSlots.insert(face.columnSlots.begin() + band + 1, slot);
+}
+
+uint8_t SparseStickerStorage::GetPhysical(unsigned int face, unsigned int x, unsigned int y) const
+{
+	auto& f = m_faces[face];
+	return f.Cell(Band(f.rows, x), Band(f.columns, y));
+}
+
+SparseStickerStorage::PhysicalLine SparseStickerStorage::Resolve(unsigned int face,
+	unsigned int x, unsigned int y, int dx, int dy) const
+{
+	auto last = m_numStickersEdge - 1;
+	auto turns = m_faceTurns[face];
+
+	auto startX = x;
+	auto startY = y;
+	StickerBuffer::ResolveFaceTurns(turns, last, startX, startY);
+
+	if (m_numStickersEdge == 1) {
+		return{ face, true, startX, startY, 1 };
+	}
+
+	unsigned int nextX = x + dx;
+	unsigned int nextY = y + dy;
+	StickerBuffer::ResolveFaceTurns(turns, last, nextX, nextY);
+
+	if (nextX == startX) {
+		return{ face, true, startX, startY, static_cast<int>(nextY) - static_cast<int>(startY) };
+	}
+	return{ face, false, startY, startX, static_cast<int>(nextX) - static_cast<int>(startX) };
+}
+
+void SparseStickerStorage::ReadLine(const PhysicalLine& line, std::vector<Run>& runs) const
+{
+	auto& face = m_faces[line.face];
+	auto& borders = line.alongRow ? face.columns : face.rows;
+	auto fixedBand = Band(line.alongRow ? face.rows : face.columns, line.fixed);
+
+	runs.clear();
+
+	for (size_t band = 0; band < borders.size(); band++) {
+		auto end = (band + 1 < borders.size()) ? borders[band + 1] : m_numStickersEdge;
+		auto color = line.alongRow ? face.Cell(fixedBand, band) : face.Cell(band, fixedBand);
+
+		if (!runs.empty() && runs.back().color == color) {
+			runs.back().length += end - borders[band];
+		}
+		else {
+			runs.push_back({ end - borders[band], color });
+		}
+	}
+
+	if (line.step < 0) {
+		std::reverse(runs.begin(), runs.end());
+	}
+}
+
+void SparseStickerStorage::WriteLine(const PhysicalLine& line, const std::vector<Run>& runs)
+{
+	auto& face = m_faces[line.face];
+
+	// The line gets a band of its own, then every run border becomes a band border
+	if (line.alongRow) {
+		SplitRows(face, line.fixed);
+		SplitRows(face, line.fixed + 1);
+	}
+	else {
+		SplitColumns(face, line.fixed);
+		SplitColumns(face, line.fixed + 1);
+	}
+
+	auto border = 0u;
+	for (auto& run : runs) {
+		border += run.length;
+		auto v = (line.step > 0) ? border : m_numStickersEdge - border;
+		line.alongRow ? SplitColumns(face, v) : SplitRows(face, v);
+	}
+
+	auto& borders = line.alongRow ? face.columns : face.rows;
+	auto fixedBand = Band(line.alongRow ? face.rows : face.columns, line.fixed);
+
+	// Runs are walked in the stored order, run borders are band borders now
+	auto run = (line.step > 0) ? runs.begin() : runs.end() - 1;
+	auto runEnd = run->length;
+
+	for (size_t band = 0; band < borders.size(); band++) {
+		if (borders[band] >= runEnd) {
+			run = (line.step > 0) ? run + 1 : run - 1;
+			runEnd += run->length;
+		}
+		auto& cell = line.alongRow ? face.Cell(fixedBand, band) : face.Cell(band, fixedBand);
+		cell = run->color;
+	}
+}
+
+uint8_t SparseStickerStorage::Get(unsigned int face, unsigned int x, unsigned int y) const
+{
+	StickerBuffer::ResolveFaceTurns(m_faceTurns[face], m_numStickersEdge - 1, x, y);
+	return GetPhysical(face, x, y);
+}
+
+void SparseStickerStorage::FillFace(unsigned int face, uint8_t color)
+{
+	auto& f = m_faces[face];
+	f.rows.assign(1, 0);
+	f.columns.assign(1, 0);
+	f.rowSlots.assign(1, 0);
+	f.columnSlots.assign(1, 0);
+	f.cells.assign(1, std::vector<uint8_t>(1, color));
+	m_faceTurns[face] = 0;
+}
+
+void SparseStickerStorage::Rotate(MoveTable::Axis axis, unsigned int layer, bool clockwise)
+{
+	auto move = MoveTable::Describe(m_numStickersEdge, axis, layer, clockwise);
+	PhysicalLine lines[4];
+
+	// Lines of a ring lie on four different faces, so all of them are read before writing
+	for (auto j = 0u; j < 4u; j++) {
+		auto& l = move.ring[j];
+		lines[j] = Resolve(l.face, l.x, l.y, l.dx, l.dy);
+		ReadLine(lines[j], m_runs[j]);
+	}
+	for (auto j = 0u; j < 4u; j++) {
+		WriteLine(lines[j], m_runs[(j + 1) & 3u]);
+	}
+
+	if (move.turnsFace) {
+		m_faceTurns[move.face] = (m_faceTurns[move.face] + (move.faceClockwise ? 1u : 3u)) & 3u;
+	}
+}
+
+unsigned int SparseStickerStorage::RunLength(unsigned int face, unsigned int x, unsigned int y,
+	int dx, int dy, unsigned int maxLength) const
+{
+	auto& f = m_faces[face];
+	auto line = Resolve(face, x, y, dx, dy);
+	auto& borders = line.alongRow ? f.columns : f.rows;
+	auto fixedBand = Band(line.alongRow ? f.rows : f.columns, line.fixed);
+
+	auto band = Band(borders, line.start);
+	auto color = line.alongRow ? f.Cell(fixedBand, band) : f.Cell(band, fixedBand);
+	auto length = 0u;
+
+	// Skip whole bands of the same color, the line walks to the neighbouring band every time
+	for (auto stored = line.start;;) {
+		auto bandEnd = (band + 1 < borders.size()) ? borders[band + 1] : m_numStickersEdge;
+		length += (line.step > 0) ? bandEnd - stored : stored - borders[band] + 1;
+
+		if (length >= maxLength) {
+			break;
+		}
+		stored = (line.step > 0) ? bandEnd : borders[band] - 1;
+		band = (line.step > 0) ? band + 1 : band - 1;
+
+		if ((line.alongRow ? f.Cell(fixedBand, band) : f.Cell(band, fixedBand)) != color) {
+			break;
+		}
+	}
+	return std::min(length, maxLength);
+}
+
+unsigned int SparseStickerStorage::EqualRows(unsigned int face, unsigned int x, unsigned int endX) const
+{
+	if (m_numStickersEdge == 1) {
+		return 1u;
+	}
+
+	// Walking over rows seen on the cube walks over stored columns if the face is turned by a quarter
+	auto& f = m_faces[face];
+	auto across = Resolve(face, x, 0, 1, 0);
+	auto& borders = across.alongRow ? f.columns : f.rows;
+	auto band = Band(borders, across.start);
+	auto bandEnd = (band + 1 < borders.size()) ? borders[band + 1] : m_numStickersEdge;
+	auto rows = (across.step > 0) ? bandEnd - across.start : across.start - borders[band] + 1;
+
+	return std::min(rows, endX - x);
+}
+
+void SparseStickerStorage::Read(uint8_t* stickers) const
+{
+	for (auto face = 0u; face < StickerBuffer::NUM_FACES; face++) {
+		for (auto x = 0u; x < m_numStickersEdge; x++) {
+			for (auto y = 0u; y < m_numStickersEdge; y++) {
+				*stickers++ = Get(face, x, y);
+			}
+		}
+	}
+}
+
+void SparseStickerStorage::Write(const uint8_t* stickers)
+{
+	auto n = m_numStickersEdge;
+	auto faceStride = static_cast<size_t>(n) * n;
+
+	// Every sticker gets a cell of its own
+	for (auto face = 0u; face < StickerBuffer::NUM_FACES; face++) {
+		auto& f = m_faces[face];
+		f.rows.resize(n);
+		f.columns.resize(n);
+		f.cells.resize(n);
+
+		for (auto v = 0u; v < n; v++) {
+			f.rows[v] = v;
+			f.columns[v] = v;
+			auto row = stickers + face * faceStride + static_cast<size_t>(v) * n;
+			f.cells[v].assign(row, row + n);
+		}
+		f.rowSlots = f.rows;
+		f.columnSlots = f.columns;
+		m_faceTurns[face] = 0;
+	}
+}
+
+size_t SparseStickerStorage::NumCells() const
+{
+	size_t numCells = 0;
+
+	for (auto& face : m_faces) {
+		numCells += face.rows.size() * face.columns.size();
+	}
+	return numCells;
+}
\ No newline at end of file
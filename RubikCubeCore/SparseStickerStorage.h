@@ -0,0 +1,93 @@
+#ifndef SPARSE_STICKER_STORAGE_H
+#define SPARSE_STICKER_STORAGE_H
+
+#include "StickerStorage.h"
+#include "StickerBuffer.h"
+#include "MoveTable.h"
+
+#include <memory>
+#include <vector>
+
+// Stickers of gigantic cubes with few moves, the solved state is stored implicitly
+// Every face is a grid of bands: rows and columns between two touched lines share their colors,
+// so a face is one cell until a move touches it and memory grows with moves, not with N^2
+// A move reads its four lines as runs of colors and writes them back, new band borders are inserted on the way
+// A new band takes the next free slot of the grid, so a split copies one row or one column of cells only
+// Faces are turned lazily through orientation tags just like in StickerBuffer
+class SparseStickerStorage final : public StickerStorage {
+private:
+
+	struct Face {
+		// First stored rows of row bands and first stored columns of column bands, both start with 0
+		std::vector<unsigned int> rows;
+		std::vector<unsigned int> columns;
+		// Slots of the bands above in cells, in the order of bands
+		std::vector<unsigned int> rowSlots;
+		std::vector<unsigned int> columnSlots;
+		// Color of every band crossing, indexed by row slot and column slot
+		std::vector<std::vector<uint8_t>> cells;
+
+		uint8_t& Cell(size_t rowBand, size_t columnBand) { return cells[rowSlots[rowBand]][columnSlots[columnBand]]; }
+		uint8_t Cell(size_t rowBand, size_t columnBand) const { return cells[rowSlots[rowBand]][columnSlots[columnBand]]; }
+	};
+
+	// Stored stickers of a line as seen on the cube, the line is one stored row (x fixed) or column (y fixed)
+	// Sticker k of the line is stored on position start + k * step in the other coordinate
+	struct PhysicalLine {
+		unsigned int face;
+		bool alongRow;
+		unsigned int fixed;
+		unsigned int start;
+		int step;
+	};
+
+	struct Run {
+		unsigned int length;
+		uint8_t color;
+	};
+
+	Face m_faces[StickerBuffer::NUM_FACES];
+	unsigned int m_numStickersEdge;
+	uint8_t m_faceTurns[StickerBuffer::NUM_FACES];
+
+	// Scratch runs of the four lines of a move
+	std::vector<Run> m_runs[4];
+
+	// Index of the band containing stored coordinate v
+	static size_t Band(const std::vector<unsigned int>& borders, unsigned int v);
+
+	// Start a new band on stored row/column v, the new band has the colors of the old one
+	void SplitRows(Face& face, unsigned int v);
+	void SplitColumns(Face& face, unsigned int v);
+
+	uint8_t GetPhysical(unsigned int face, unsigned int x, unsigned int y) const;
+
+	PhysicalLine Resolve(unsigned int face, unsigned int x, unsigned int y, int dx, int dy) const;
+
+	void ReadLine(const PhysicalLine& line, std::vector<Run>& runs) const;
+	void WriteLine(const PhysicalLine& line, const std::vector<Run>& runs);
+
+public:
+
+	explicit SparseStickerStorage(unsigned int numStickersEdge);
+
+	unsigned int NumStickersEdge() const override { return m_numStickersEdge; }
+	std::unique_ptr<StickerStorage> Clone() const override { return std::make_unique<SparseStickerStorage>(*this); }
+
+	uint8_t Get(unsigned int face, unsigned int x, unsigned int y) const override;
+	void FillFace(unsigned int face, uint8_t color) override;
+
+	void Rotate(MoveTable::Axis axis, unsigned int layer, bool clockwise) override;
+
+	unsigned int RunLength(unsigned int face, unsigned int x, unsigned int y, int dx, int dy, unsigned int maxLength) const override;
+	unsigned int EqualRows(unsigned int face, unsigned int x, unsigned int endX) const override;
+
+	// Every sticker is visited, use them on small cubes only
+	void Read(uint8_t* stickers) const override;
+	void Write(const uint8_t* stickers) override;
+
+	// Number of band crossings of all faces, memory taken by stickers
+	size_t NumCells() const;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,72 @@
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <atomic>
+#include <utility>
+#include <cstddef>
+
+// Bounded lock-free ring between exactly one producer thread and one consumer thread
+// Each side owns one index and only reads the other one, indices are a cache line apart
+// Padding is used instead of alignas, over-aligned types are not allocated aligned by new before C++17
+// CAPACITY must be a power of two
+template <typename T, size_t CAPACITY>
+class SpscRing final {
+private:
+
+	static_assert(CAPACITY > 0 && (CAPACITY & (CAPACITY - 1)) == 0, "SpscRing: capacity must be a power of two");
+
+	static constexpr size_t CACHE_LINE = 64u;
+
+	// Next slot to read, written by the consumer only
+	std::atomic<size_t> m_head;
+	char m_headPadding[CACHE_LINE - sizeof(std::atomic<size_t>)];
+	// Next slot to write, written by the producer only
+	std::atomic<size_t> m_tail;
+	char m_tailPadding[CACHE_LINE - sizeof(std::atomic<size_t>)];
+	T m_slots[CAPACITY];
+
+public:
+
+	SpscRing() : m_head(0), m_tail(0) {}
+
+	SpscRing(const SpscRing&) = delete;
+	SpscRing& operator=(const SpscRing&) = delete;
+
+	// Producer side, returns false if the ring is full
+	bool TryPush(T&& value)
+	{
+		auto tail = m_tail.load(std::memory_order_relaxed);
+
+		if (tail - m_head.load(std::memory_order_acquire) == CAPACITY) {
+			return false;
+		}
+		m_slots[tail & (CAPACITY - 1)] = std::move(value);
+		m_tail.store(tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	// Consumer side, the oldest value or nullptr if the ring is empty
+	// The value stays in the ring until Pop() is called
+	T* Front()
+	{
+		auto head = m_head.load(std::memory_order_relaxed);
+
+		if (head == m_tail.load(std::memory_order_acquire)) {
+			return nullptr;
+		}
+		return &m_slots[head & (CAPACITY - 1)];
+	}
+
+	// Consumer side, release the slot returned by Front()
+	void Pop()
+	{
+		auto head = m_head.load(std::memory_order_relaxed);
+		m_slots[head & (CAPACITY - 1)] = T();
+		m_head.store(head + 1, std::memory_order_release);
+	}
+
+	// Approximate number of values, exact on either side when the other one is idle
+	size_t Size() const { return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire); }
+};
+
+#endif
\ No newline at end of file
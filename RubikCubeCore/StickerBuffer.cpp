@@ -0,0 +1,196 @@
+#include "StickerBuffer.h"
+#include "WorkerPool.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+StickerBuffer::StickerBuffer()
+{
+	ResetAll();
+}
+
+StickerBuffer::StickerBuffer(unsigned int numStickersEdge)
+{
+	ResetAll();
+	Resize(numStickersEdge);
+}
+
+StickerBuffer::StickerBuffer(StickerBuffer&& b)
+{
+	ResetAll();
+	*this = std::move(b);
+}
+
+StickerBuffer& StickerBuffer::operator=(StickerBuffer&& b)
+{
+	m_memory = std::move(b.m_memory);
+	m_data = b.m_data;
+	m_numStickersEdge = b.m_numStickersEdge;
+	m_faceStride = b.m_faceStride;
+	std::memcpy(m_faceTurns, b.m_faceTurns, sizeof(m_faceTurns));
+	b.ResetAll();
+	return *this;
+}
+
+StickerBuffer::StickerBuffer(const StickerBuffer& b)
+{
+	ResetAll();
+	*this = b;
+}
+
+StickerBuffer& StickerBuffer::operator=(const StickerBuffer& b)
+{
+	if (this != &b) {
+		Resize(b.m_numStickersEdge);
+		std::memcpy(m_data, b.m_data, b.Size());
+		std::memcpy(m_faceTurns, b.m_faceTurns, sizeof(m_faceTurns));
+	}
+	return *this;
+}
+
+void StickerBuffer::ResetAll()
+{
+	m_memory.reset();
+	m_data = nullptr;
+	m_numStickersEdge = 0;
+	m_faceStride = 0;
+	ResetFaceTurns();
+}
+
+void StickerBuffer::ResetFaceTurns()
+{
+	std::memset(m_faceTurns, 0, sizeof(m_faceTurns));
+}
+
+void StickerBuffer::Resize(unsigned int numStickersEdge)
+{
+	if (numStickersEdge == m_numStickersEdge) {
+		ResetFaceTurns();
+		return;
+	}
+	ResetAll();
+
+	if (numStickersEdge == 0) {
+		return;
+	}
+	m_numStickersEdge = numStickersEdge;
+	m_faceStride = static_cast<size_t>(numStickersEdge) * numStickersEdge;
+
+	// Over-allocate and align manually, the whole buffer is padded to the full cache line
+	auto size = (Size() + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+	m_memory.reset(new uint8_t[size + ALIGNMENT - 1]);
+
+	auto address = reinterpret_cast<uintptr_t>(m_memory.get());
+	auto alignedAddress = (address + ALIGNMENT - 1) & ~static_cast<uintptr_t>(ALIGNMENT - 1);
+	m_data = m_memory.get() + (alignedAddress - address);
+	std::memset(m_data, 0, size);
+}
+
+void StickerBuffer::StickerPosition(unsigned int n, unsigned int face, unsigned int x, unsigned int y, int position[3])
+{
+	int cx = 2 * static_cast<int>(x) - static_cast<int>(n) + 1;
+	int cy = 2 * static_cast<int>(y) - static_cast<int>(n) + 1;
+	int edge = static_cast<int>(n);
+
+	switch (face) {
+	case TOP:    position[0] = cx;    position[1] = edge;  position[2] = cy;    break;
+	case BOTTOM: position[0] = cx;    position[1] = -edge; position[2] = -cy;   break;
+	case LEFT:   position[0] = -edge; position[1] = cx;    position[2] = cy;    break;
+	case RIGHT:  position[0] = edge;  position[1] = -cx;   position[2] = cy;    break;
+	case FRONT:  position[0] = cx;    position[1] = -cy;   position[2] = edge;  break;
+	default:     position[0] = cx;    position[1] = cy;    position[2] = -edge; break;
+	}
+}
+
+void StickerBuffer::StickerAtPosition(unsigned int n, const int position[3], unsigned int& face, unsigned int& x, unsigned int& y)
+{
+	int edge = static_cast<int>(n);
+	int cx, cy;
+
+	if (position[1] == edge)       { face = TOP;    cx = position[0];  cy = position[2];  }
+	else if (position[1] == -edge) { face = BOTTOM; cx = position[0];  cy = -position[2]; }
+	else if (position[0] == -edge) { face = LEFT;   cx = position[1];  cy = position[2];  }
+	else if (position[0] == edge)  { face = RIGHT;  cx = -position[1]; cy = position[2];  }
+	else if (position[2] == edge)  { face = FRONT;  cx = position[0];  cy = -position[1]; }
+	else                           { face = BACK;   cx = position[0];  cy = position[1];  }
+
+	x = static_cast<unsigned int>(cx + edge - 1) / 2u;
+	y = static_cast<unsigned int>(cy + edge - 1) / 2u;
+}
+
+void StickerBuffer::FillFace(unsigned int face, uint8_t value)
+{
+	std::memset(FaceData(face), value, m_faceStride);
+	m_faceTurns[face] = 0;
+}
+
+bool StickerBuffer::IsCanonical() const
+{
+	for (auto turns : m_faceTurns) {
+		if (turns != 0) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void StickerBuffer::CopyFace(unsigned int face, uint8_t* destination) const
+{
+	auto n = m_numStickersEdge;
+
+	if (m_faceTurns[face] == 0) {
+		std::memcpy(destination, FaceData(face), m_faceStride);
+		return;
+	}
+
+	// Stored position of [x, y] is origin + x * stepX + y * stepY for any turn
+	auto origin = static_cast<ptrdiff_t>(Index(face, 0, 0));
+	auto stepX = (n > 1) ? static_cast<ptrdiff_t>(Index(face, 1, 0)) - origin : 0;
+	auto stepY = (n > 1) ? static_cast<ptrdiff_t>(Index(face, 0, 1)) - origin : 0;
+	auto source = m_data + origin;
+	auto numTiles = (n + FACE_TILE - 1) / FACE_TILE;
+
+	// One task copies one row of tiles
+	auto copyTiles = [&](size_t tileX) {
+		auto startX = static_cast<unsigned int>(tileX) * FACE_TILE;
+		auto endX = std::min(startX + FACE_TILE, n);
+
+		for (auto startY = 0u; startY < n; startY += FACE_TILE) {
+			auto endY = std::min(startY + FACE_TILE, n);
+
+			for (auto x = startX; x < endX; x++) {
+				auto in = source + x * stepX + startY * stepY;
+				auto out = destination + static_cast<size_t>(x) * n + startY;
+
+				for (auto y = startY; y < endY; y++, in += stepY) {
+					*out++ = *in;
+				}
+			}
+		}
+	};
+
+	if (m_faceStride >= MIN_PARALLEL_FACE_STICKERS) {
+		WorkerPool::Shared().Run(numTiles, copyTiles);
+	}
+	else {
+		for (auto tileX = 0u; tileX < numTiles; tileX++) {
+			copyTiles(tileX);
+		}
+	}
+}
+
+void StickerBuffer::Canonicalize()
+{
+	std::vector<uint8_t> face;
+
+	for (auto f = 0u; f < NUM_FACES; f++) {
+		if (m_faceTurns[f] == 0) {
+			continue;
+		}
+		face.resize(m_faceStride);
+		CopyFace(f, face.data());
+		std::memcpy(FaceData(f), face.data(), m_faceStride);
+		m_faceTurns[f] = 0;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,139 @@
+#ifndef STICKER_BUFFER_H
+#define STICKER_BUFFER_H
+
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+
+// Contiguous storage of all stickers of the cube (one byte per sticker)
+// Faces are stored one after another, every face row by row
+// The buffer is aligned to the cache line, so small cubes fit into a single one
+// Every face carries an orientation tag (number of pending clockwise quarter turns),
+// so turning the whole face is O(1) and all sticker accesses are resolved through the tag
+class StickerBuffer final {
+public:
+
+	static constexpr unsigned int NUM_FACES = 6u;
+	static constexpr size_t ALIGNMENT = 64u;
+
+	// Edge of square tiles copied at once when a turned face is materialized, source tile fits into L1 cache
+	static constexpr unsigned int FACE_TILE = 64u;
+
+	// Smaller faces are copied on the calling thread only
+	static constexpr size_t MIN_PARALLEL_FACE_STICKERS = 256u * 256u;
+
+	// Order of faces inside the buffer
+	enum FaceIndex {
+		TOP = 0,
+		BOTTOM,
+		LEFT,
+		RIGHT,
+		FRONT,
+		BACK
+	};
+
+private:
+
+	std::unique_ptr<uint8_t[]> m_memory;
+	uint8_t* m_data;
+	unsigned int m_numStickersEdge;
+	size_t m_faceStride;
+	uint8_t m_faceTurns[NUM_FACES];
+
+	// Reset all values to zero, do not destroy anything
+	void ResetAll();
+
+public:
+
+	StickerBuffer();
+	explicit StickerBuffer(unsigned int numStickersEdge);
+
+	StickerBuffer(StickerBuffer&& b);
+	StickerBuffer& operator=(StickerBuffer&& b);
+
+	StickerBuffer(const StickerBuffer& b);
+	StickerBuffer& operator=(const StickerBuffer& b);
+
+	// Reallocate the buffer for given cube's level, content is undefined afterwards
+	void Resize(unsigned int numStickersEdge);
+
+	unsigned int NumStickersEdge() const { return m_numStickersEdge; }
+
+	// Total number of stickers
+	size_t Size() const { return NUM_FACES * m_faceStride; }
+
+	size_t FaceStride() const { return m_faceStride; }
+	size_t RowStride() const { return m_numStickersEdge; }
+
+	// Index of the sticker inside the stored (not yet turned) face
+	size_t PhysicalIndex(unsigned int face, unsigned int x, unsigned int y) const
+		{ return face * m_faceStride + x * RowStride() + y; }
+
+	// Index of the sticker on position [x, y] of the face as it is seen on the cube
+	size_t Index(unsigned int face, unsigned int x, unsigned int y) const
+	{
+		ResolveFaceTurns(m_faceTurns[face], m_numStickersEdge - 1, x, y);
+		return PhysicalIndex(face, x, y);
+	}
+
+	// Convert position [x, y] seen on the face turned by given number of clockwise quarter turns
+	// into position inside the stored face, last is the last index of the row
+	static void ResolveFaceTurns(unsigned int turns, unsigned int last, unsigned int& x, unsigned int& y)
+	{
+		auto seenX = x;
+
+		switch (turns) {
+		case 1:
+			x = last - y;
+			y = seenX;
+			break;
+		case 2:
+			x = last - x;
+			y = last - y;
+			break;
+		case 3:
+			x = y;
+			y = last - seenX;
+			break;
+		}
+	}
+
+	// Doubled coordinates of the sticker center, the cube spans <-N, N> on every axis
+	// Faces are placed the same way as RubikCubeRenderer draws them
+	static void StickerPosition(unsigned int n, unsigned int face, unsigned int x, unsigned int y, int position[3]);
+
+	// Inverse of StickerPosition(), position must be a center of some sticker
+	static void StickerAtPosition(unsigned int n, const int position[3], unsigned int& face, unsigned int& x, unsigned int& y);
+
+	uint8_t& At(unsigned int face, unsigned int x, unsigned int y) { return m_data[Index(face, x, y)]; }
+	uint8_t At(unsigned int face, unsigned int x, unsigned int y) const { return m_data[Index(face, x, y)]; }
+
+	// Raw stored stickers, faces are in canonical rows only if IsCanonical()
+	uint8_t* Data() { return m_data; }
+	const uint8_t* Data() const { return m_data; }
+
+	uint8_t* FaceData(unsigned int face) { return m_data + face * m_faceStride; }
+	const uint8_t* FaceData(unsigned int face) const { return m_data + face * m_faceStride; }
+
+	// Fill the whole face with one color, resets its orientation tag
+	void FillFace(unsigned int face, uint8_t value);
+
+	// Turn the whole face by a quarter, only the orientation tag is updated
+	void TurnFace(unsigned int face, bool clockwise)
+		{ m_faceTurns[face] = (m_faceTurns[face] + (clockwise ? 1u : 3u)) & 3u; }
+
+	unsigned int FaceTurns(unsigned int face) const { return m_faceTurns[face]; }
+
+	// Forget pending face turns, used when the raw content is replaced by canonical rows
+	void ResetFaceTurns();
+	bool IsCanonical() const;
+
+	// Copy the face as seen on the cube, row by row, into numStickersEdge^2 bytes
+	// Turned faces are copied in cache-sized tiles, big faces are split between workers of the shared pool
+	void CopyFace(unsigned int face, uint8_t* destination) const;
+
+	// Physically rotate all turned faces, so stored rows are the ones seen on the cube
+	void Canonicalize();
+};
+
+#endif
\ No newline at end of file
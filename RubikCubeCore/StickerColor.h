@@ -0,0 +1,22 @@
+#ifndef STICKER_COLOR_H
+#define STICKER_COLOR_H
+
+// Colors of stickers, values are stored in save files
+class StickerColor final {
+public:
+
+	enum Color {
+		WHITE = 0,
+		RED,
+		BLUE,
+		ORANGE,
+		GREEN,
+		YELLOW
+	};
+
+	static constexpr unsigned int NUM_COLORS = 6u;
+
+	StickerColor() = delete;
+};
+
+#endif
\ No newline at end of file
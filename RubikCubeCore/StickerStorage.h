@@ -0,0 +1,50 @@
+#ifndef STICKER_STORAGE_H
+#define STICKER_STORAGE_H
+
+#include "MoveTable.h"
+
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+
+// Storage of all stickers of the cube together with its move kernels
+// Implementations differ in memory layout, all of them expose stickers as seen on the cube
+class StickerStorage {
+public:
+
+	virtual ~StickerStorage() {}
+
+	virtual unsigned int NumStickersEdge() const = 0;
+
+	// Independent copy of all stickers
+	virtual std::unique_ptr<StickerStorage> Clone() const = 0;
+
+	// Total number of stickers
+	size_t Size() const { return 6u * static_cast<size_t>(NumStickersEdge()) * NumStickersEdge(); }
+
+	virtual uint8_t Get(unsigned int face, unsigned int x, unsigned int y) const = 0;
+	virtual void FillFace(unsigned int face, uint8_t color) = 0;
+
+	virtual void Rotate(MoveTable::Axis axis, unsigned int layer, bool clockwise) = 0;
+
+	// Number of stickers with the same color from [x, y] on in direction [dx, dy], at most maxLength
+	virtual unsigned int RunLength(unsigned int face, unsigned int x, unsigned int y, int dx, int dy, unsigned int maxLength) const
+	{
+		auto color = Get(face, x, y);
+		auto length = 1u;
+
+		while (length < maxLength && Get(face, x + length * dx, y + length * dy) == color) {
+			length++;
+		}
+		return length;
+	}
+
+	// Number of rows from the row x on known to be equal to the row x, at most endX - x
+	virtual unsigned int EqualRows(unsigned int, unsigned int, unsigned int) const { return 1u; }
+
+	// Copy all stickers face by face, row by row as seen on the cube, from/into Size() bytes
+	virtual void Read(uint8_t* stickers) const = 0;
+	virtual void Write(const uint8_t* stickers) = 0;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,94 @@
+#include "WorkerPool.h"
+
+#include <algorithm>
+
+WorkerPool::WorkerPool(unsigned int numThreads)
+	: m_task(nullptr),
+	m_numTasks(0),
+	m_nextTask(0),
+	m_busyWorkers(0),
+	m_generation(0),
+	m_stopping(false)
+{
+	m_threads.reserve(numThreads);
+
+	for (auto i = 0u; i < numThreads; i++) {
+		m_threads.emplace_back([this]() { WorkerLoop(); });
+	}
+}
+
+WorkerPool::~WorkerPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stopping = true;
+	}
+	m_wake.notify_all();
+
+	for (auto& thread : m_threads) {
+		thread.join();
+	}
+}
+
+WorkerPool& WorkerPool::Shared()
+{
+	static WorkerPool pool(std::max(std::thread::hardware_concurrency(), 1u) - 1u);
+	return pool;
+}
+
+void WorkerPool::WorkerLoop()
+{
+	uint64_t generation = 0;
+
+	for (;;) {
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_wake.wait(lock, [&]() { return m_stopping || m_generation != generation; });
+
+			if (m_stopping) {
+				return;
+			}
+			generation = m_generation;
+		}
+
+		Work();
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (--m_busyWorkers == 0) {
+			m_done.notify_one();
+		}
+	}
+}
+
+void WorkerPool::Work()
+{
+	for (auto i = m_nextTask++; i < m_numTasks; i = m_nextTask++) {
+		(*m_task)(i);
+	}
+}
+
+void WorkerPool::Run(size_t numTasks, const std::function<void(size_t)>& task)
+{
+	if (m_threads.empty() || numTasks <= 1) {
+		for (size_t i = 0; i < numTasks; i++) {
+			task(i);
+		}
+		return;
+	}
+
+	std::lock_guard<std::mutex> runLock(m_runMutex);
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_task = &task;
+		m_numTasks = numTasks;
+		m_nextTask = 0;
+		m_busyWorkers = m_threads.size();
+		m_generation++;
+	}
+	m_wake.notify_all();
+
+	Work();
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_done.wait(lock, [&]() { return m_busyWorkers == 0; });
+}
\ No newline at end of file
@@ -0,0 +1,56 @@
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+// Fixed set of worker threads for splitting big kernels (face rotations, batch moves) into tasks
+// The calling thread works on tasks as well, Run() returns once all tasks are finished
+// Tasks must not throw
+class WorkerPool final {
+private:
+
+	std::vector<std::thread> m_threads;
+
+	// Only one Run() at a time
+	std::mutex m_runMutex;
+
+	std::mutex m_mutex;
+	std::condition_variable m_wake;
+	std::condition_variable m_done;
+
+	const std::function<void(size_t)>* m_task;
+	size_t m_numTasks;
+	std::atomic<size_t> m_nextTask;
+	size_t m_busyWorkers;
+	uint64_t m_generation;
+	bool m_stopping;
+
+	void WorkerLoop();
+	void Work();
+
+public:
+
+	explicit WorkerPool(unsigned int numThreads);
+	~WorkerPool();
+
+	WorkerPool(const WorkerPool&) = delete;
+	WorkerPool& operator=(const WorkerPool&) = delete;
+
+	// Pool shared by all kernels, one thread per hardware thread including the caller
+	static WorkerPool& Shared();
+
+	// Number of threads working on tasks, including the caller
+	unsigned int NumThreads() const { return static_cast<unsigned int>(m_threads.size()) + 1u; }
+
+	// Run task(i) for every i from <0, numTasks)
+	void Run(size_t numTasks, const std::function<void(size_t)>& task);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,173 @@
+#include "ZobristHash.h"
+
+#include <algorithm>
+#include <cstring>
+
+ZobristHash::ZobristHash()
+	: m_numStickersEdge(1)
+{
+	std::memset(m_solvedColors, 0, sizeof(m_solvedColors));
+	std::memset(m_faceHashes, 0, sizeof(m_faceHashes));
+}
+
+uint64_t ZobristHash::Mix(unsigned int face, unsigned int x, unsigned int y, uint8_t color) const
+{
+	// Rectangle keys use corners up to N
+	auto n = static_cast<uint64_t>(m_numStickersEdge) + 1u;
+
+	// splitmix64 finalizer of the position, cubes of different levels get different keys
+	auto z = ((((face * n + x) * n + y) << 3 | color) ^ (n << 40)) + 0x9E3779B97F4A7C15ull;
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+	return z ^ (z >> 31);
+}
+
+void ZobristHash::ReplaceSticker(unsigned int face, unsigned int x, unsigned int y, uint8_t oldColor, uint8_t newColor)
+{
+	if (oldColor == newColor) {
+		return;
+	}
+	auto last = m_numStickersEdge - 1;
+
+	// Sticker seen on [x, y] would be seen on the position resolved by the inverse turns
+	for (auto r = 0u; r < 4u; r++) {
+		auto px = x;
+		auto py = y;
+		StickerBuffer::ResolveFaceTurns((4u - r) & 3u, last, px, py);
+		m_faceHashes[face][r] ^= Key(face, px, py, oldColor) ^ Key(face, px, py, newColor);
+	}
+}
+
+void ZobristHash::ToggleRun(const MoveTable::Line& line, unsigned int k, unsigned int length, uint8_t color)
+{
+	auto last = m_numStickersEdge - 1;
+	auto endK = k + length - 1;
+
+	// A run is a rectangle one sticker wide in every orientation of the face
+	for (auto r = 0u; r < 4u; r++) {
+		unsigned int x0 = line.x + k * line.dx;
+		unsigned int y0 = line.y + k * line.dy;
+		unsigned int x1 = line.x + endK * line.dx;
+		unsigned int y1 = line.y + endK * line.dy;
+		StickerBuffer::ResolveFaceTurns((4u - r) & 3u, last, x0, y0);
+		StickerBuffer::ResolveFaceTurns((4u - r) & 3u, last, x1, y1);
+
+		m_faceHashes[line.face][r] ^= RectangleKey(line.face, std::min(x0, x1), std::min(y0, y1),
+			std::max(x0, x1) + 1u, std::max(y0, y1) + 1u, color);
+	}
+}
+
+void ZobristHash::ResetSolved(unsigned int numStickersEdge, const uint8_t* faceColors)
+{
+	m_numStickersEdge = numStickersEdge;
+	std::memcpy(m_solvedColors, faceColors, sizeof(m_solvedColors));
+	std::memset(m_faceHashes, 0, sizeof(m_faceHashes));
+}
+
+void ZobristHash::Reset(unsigned int numStickersEdge, const uint8_t* faceColors, const uint8_t* stickers)
+{
+	ResetSolved(numStickersEdge, faceColors);
+
+	for (auto face = 0u; face < StickerBuffer::NUM_FACES; face++) {
+		for (auto x = 0u; x < numStickersEdge; x++) {
+			for (auto y = 0u; y < numStickersEdge; y++) {
+				ReplaceSticker(face, x, y, m_solvedColors[face], *stickers++);
+			}
+		}
+	}
+}
+
+void ZobristHash::Restore(unsigned int numStickersEdge, const uint8_t* faceColors, const FaceHashes& faceHashes)
+{
+	ResetSolved(numStickersEdge, faceColors);
+	std::memcpy(m_faceHashes, faceHashes.values, sizeof(m_faceHashes));
+}
+
+ZobristHash::FaceHashes ZobristHash::GetFaceHashes() const
+{
+	FaceHashes faceHashes;
+	std::memcpy(faceHashes.values, m_faceHashes, sizeof(m_faceHashes));
+	return faceHashes;
+}
+
+void ZobristHash::RotateStickers(const StickerStorage& stickers, const MoveTable::MoveDescription& move)
+{
+	// Colors are moved from ring[j + 1] into ring[j]
+	for (auto k = 0; k < static_cast<int>(m_numStickersEdge); k++) {
+		unsigned int x[4];
+		unsigned int y[4];
+		uint8_t colors[4];
+
+		for (auto j = 0u; j < 4u; j++) {
+			auto& l = move.ring[j];
+			x[j] = l.x + k * l.dx;
+			y[j] = l.y + k * l.dy;
+			colors[j] = stickers.Get(l.face, x[j], y[j]);
+		}
+		for (auto j = 0u; j < 4u; j++) {
+			ReplaceSticker(move.ring[j].face, x[j], y[j], colors[j], colors[(j + 1) & 3u]);
+		}
+	}
+}
+
+void ZobristHash::RotateRuns(const StickerStorage& stickers, const MoveTable::MoveDescription& move)
+{
+	auto n = m_numStickersEdge;
+
+	for (auto j = 0u; j < 4u; j++) {
+		auto& l = move.ring[j];
+		m_runs[j].clear();
+
+		for (auto k = 0u; k < n;) {
+			unsigned int x = l.x + k * l.dx;
+			unsigned int y = l.y + k * l.dy;
+			auto length = stickers.RunLength(l.face, x, y, l.dx, l.dy, n - k);
+
+			m_runs[j].push_back({ k, length, stickers.Get(l.face, x, y) });
+			k += length;
+		}
+	}
+
+	// Both the old and the new content cover the whole line, so keys of solved colors cancel out
+	for (auto j = 0u; j < 4u; j++) {
+		for (auto& run : m_runs[j]) {
+			ToggleRun(move.ring[j], run.start, run.length, run.color);
+		}
+		for (auto& run : m_runs[(j + 1) & 3u]) {
+			ToggleRun(move.ring[j], run.start, run.length, run.color);
+		}
+	}
+}
+
+void ZobristHash::Rotate(const StickerStorage& stickers, MoveTable::Axis axis, unsigned int layer, bool clockwise)
+{
+	auto move = MoveTable::Describe(m_numStickersEdge, axis, layer, clockwise);
+
+	if (HashesRuns()) {
+		RotateRuns(stickers, move);
+	}
+	else {
+		RotateStickers(stickers, move);
+	}
+
+	// Sticker seen on [x, y] of a turned face was seen on [x, y] resolved by one turn before
+	if (move.turnsFace) {
+		auto turns = move.faceClockwise ? 1u : 3u;
+		uint64_t hashes[4];
+		std::memcpy(hashes, m_faceHashes[move.face], sizeof(hashes));
+
+		for (auto r = 0u; r < 4u; r++) {
+			m_faceHashes[move.face][r] = hashes[(r + turns) & 3u];
+		}
+	}
+}
+
+uint64_t ZobristHash::Value() const
+{
+	uint64_t hash = 0;
+
+	for (auto face = 0u; face < StickerBuffer::NUM_FACES; face++) {
+		hash ^= m_faceHashes[face][0];
+	}
+	return hash;
+}
\ No newline at end of file
@@ -0,0 +1,87 @@
+#ifndef ZOBRIST_HASH_H
+#define ZOBRIST_HASH_H
+
+#include "MoveTable.h"
+#include "StickerBuffer.h"
+#include "StickerStorage.h"
+
+#include <vector>
+#include <cstdint>
+
+// 64-bit Zobrist hash of stickers as seen on the cube, XOR of one random key per (position, color)
+// Keys of colors of the solved cube are XORed out, so the solved cube hashes to 0 without visiting stickers
+// A move updates only the 4N stickers of its ring, so it takes O(N) instead of O(N^2)
+// Every face keeps its hash for all 4 orientations, so turning an outer face only swaps them
+// Keys are mixed from the position instead of being stored, big cubes would need hundreds of MB of keys
+class ZobristHash final {
+public:
+
+	// Levels from this one up use keys which are 2D differences of mixed values, so keys of any rectangle
+	// of stickers XOR into 4 values and a move takes O(runs of colors) instead of O(N)
+	static constexpr unsigned int MIN_RUN_STICKERS_EDGE = 1024u;
+
+	// Hashes of all faces in all orientations, the hash of the same stickers is restored from them without
+	// visiting stickers
+	struct FaceHashes {
+		uint64_t values[StickerBuffer::NUM_FACES][4];
+	};
+
+private:
+
+	struct Run {
+		unsigned int start;
+		unsigned int length;
+		uint8_t color;
+	};
+
+	unsigned int m_numStickersEdge;
+	uint8_t m_solvedColors[StickerBuffer::NUM_FACES];
+
+	// Hash of the face as if it was turned by additional r clockwise quarter turns
+	uint64_t m_faceHashes[StickerBuffer::NUM_FACES][4];
+
+	// Scratch runs of the four lines of a move
+	std::vector<Run> m_runs[4];
+
+	bool HashesRuns() const { return m_numStickersEdge >= MIN_RUN_STICKERS_EDGE; }
+
+	uint64_t Mix(unsigned int face, unsigned int x, unsigned int y, uint8_t color) const;
+
+	// XOR of keys of stickers <x0, x1) x <y0, y1) of one color, only for levels which hash runs
+	uint64_t RectangleKey(unsigned int face, unsigned int x0, unsigned int y0, unsigned int x1, unsigned int y1, uint8_t color) const
+		{ return Mix(face, x0, y0, color) ^ Mix(face, x1, y0, color) ^ Mix(face, x0, y1, color) ^ Mix(face, x1, y1, color); }
+
+	uint64_t Key(unsigned int face, unsigned int x, unsigned int y, uint8_t color) const
+		{ return HashesRuns() ? RectangleKey(face, x, y, x + 1, y + 1, color) : Mix(face, x, y, color); }
+
+	// Replace the color on position [x, y] of the face as it is seen on the cube
+	void ReplaceSticker(unsigned int face, unsigned int x, unsigned int y, uint8_t oldColor, uint8_t newColor);
+
+	// Add or remove length stickers of one color from the sticker k of the line on
+	void ToggleRun(const MoveTable::Line& line, unsigned int k, unsigned int length, uint8_t color);
+
+	void RotateStickers(const StickerStorage& stickers, const MoveTable::MoveDescription& move);
+	void RotateRuns(const StickerStorage& stickers, const MoveTable::MoveDescription& move);
+
+public:
+
+	ZobristHash();
+
+	// Hash of the solved cube, faceColors are colors of its faces
+	void ResetSolved(unsigned int numStickersEdge, const uint8_t* faceColors);
+
+	// Hash all stickers from scratch, stickers are face by face, row by row as seen on the cube
+	void Reset(unsigned int numStickersEdge, const uint8_t* faceColors, const uint8_t* stickers);
+
+	// Continue from face hashes of stickers hashed before with the same level and face colors
+	void Restore(unsigned int numStickersEdge, const uint8_t* faceColors, const FaceHashes& faceHashes);
+
+	FaceHashes GetFaceHashes() const;
+
+	// Update the hash by the move, call it before the move is performed on the stickers
+	void Rotate(const StickerStorage& stickers, MoveTable::Axis axis, unsigned int layer, bool clockwise);
+
+	uint64_t Value() const;
+};
+
+#endif
\ No newline at end of file
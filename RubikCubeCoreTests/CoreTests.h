@@ -0,0 +1,15 @@
+#ifndef CORE_TESTS_H
+#define CORE_TESTS_H
+
+// Every test prints one line per case and returns false if some case failed
+
+// CubeBatch against single cubes
+bool TestCubeBatch();
+
+// RubikCube with every kind of sticker storage against a plain copy of the original sticker model
+bool TestStickerStorage();
+
+// Save files and move logs written and read back
+bool TestFileFormats();
+
+#endif
\ No newline at end of file
@@ -0,0 +1,126 @@
+#include "CoreTests.h"
+
+#include "CompiledMoves.h"
+#include "CubeBatch.h"
+#include "RubikCube.h"
+
+#include <iostream>
+#include <random>
+#include <vector>
+#include <cstring>
+
+// Differential test of CubeBatch against single cubes
+// The same random sequence is performed by CubeBatch::Rotate, CubeBatch::ApplyCompiledMoves and RubikCube,
+// then stickers of every cube of both batches are compared with the single cube it started as
+
+namespace {
+
+	// Cubes of a batch start as copies of a few differently scrambled single cubes
+	const size_t NUM_REFERENCES = 5u;
+	const unsigned int NUM_SCRAMBLE_MOVES = 20u;
+	const unsigned int NUM_MOVES = 200u;
+
+	// Batches of this many cubes split their moves between workers
+	const size_t PARALLEL_NUM_CUBES = 20000u;
+
+	std::vector<MoveTable::Move> RandomMoves(std::mt19937& random, unsigned int numStickersEdge, unsigned int numMoves)
+	{
+		std::vector<MoveTable::Move> moves;
+
+		for (auto i = 0u; i < numMoves; i++) {
+			auto axis = static_cast<MoveTable::Axis>(random() % MoveTable::NUM_AXES);
+			moves.push_back({ axis, static_cast<unsigned int>(random() % numStickersEdge), (random() & 1u) != 0 });
+		}
+		return moves;
+	}
+
+	std::vector<uint8_t> ReadStickers(const RubikCube& cube)
+	{
+		auto& stickers = cube.GetSnapshot()->GetStickers();
+		std::vector<uint8_t> result(stickers.Size());
+		stickers.Read(result.data());
+		return result;
+	}
+
+	// Number of cubes of the batch which differ from their single cube
+	size_t CountMismatches(const CubeBatch& batch, const std::vector<std::vector<uint8_t>>& expected)
+	{
+		std::vector<uint8_t> stickers(expected.front().size());
+		size_t numMismatches = 0;
+
+		for (size_t cube = 0; cube < batch.NumCubes(); cube++) {
+			batch.ReadCube(cube, stickers.data());
+			numMismatches += stickers != expected[cube % NUM_REFERENCES];
+		}
+		return numMismatches;
+	}
+
+	bool TestBatch(unsigned int numStickersEdge, size_t numCubes, unsigned int seed)
+	{
+		std::mt19937 random(seed);
+		std::vector<std::unique_ptr<RubikCube>> references;
+		std::vector<std::vector<uint8_t>> initial;
+
+		for (size_t r = 0; r < NUM_REFERENCES; r++) {
+			references.push_back(std::make_unique<RubikCube>(numStickersEdge));
+			references.back()->ApplyMoves(RandomMoves(random, numStickersEdge, NUM_SCRAMBLE_MOVES));
+			initial.push_back(ReadStickers(*references.back()));
+		}
+
+		uint8_t faceColors[StickerBuffer::NUM_FACES] = {};
+		CubeBatch rotated(numStickersEdge, numCubes, faceColors);
+		CubeBatch compiled(numStickersEdge, numCubes, faceColors);
+
+		for (size_t cube = 0; cube < numCubes; cube++) {
+			rotated.WriteCube(cube, initial[cube % NUM_REFERENCES].data());
+			compiled.WriteCube(cube, initial[cube % NUM_REFERENCES].data());
+		}
+
+		auto moves = RandomMoves(random, numStickersEdge, NUM_MOVES);
+
+		for (auto& move : moves) {
+			rotated.Rotate(move.axis, move.layer, move.clockwise);
+		}
+		compiled.ApplyCompiledMoves(*CompiledMoves::Compile(numStickersEdge, moves));
+
+		std::vector<std::vector<uint8_t>> expected;
+
+		for (auto& reference : references) {
+			reference->ApplyMoves(moves);
+			expected.push_back(ReadStickers(*reference));
+		}
+
+		auto rotatedMismatches = CountMismatches(rotated, expected);
+		auto compiledMismatches = CountMismatches(compiled, expected);
+		bool passed = rotatedMismatches == 0 && compiledMismatches == 0;
+
+		std::cout << (passed ? "ok   " : "FAIL ") << numStickersEdge << "x" << numStickersEdge << "x" << numStickersEdge
+			<< ", " << numCubes << " cubes";
+
+		if (!passed) {
+			std::cout << ": " << rotatedMismatches << " rotated and " << compiledMismatches << " compiled cubes differ";
+		}
+		std::cout << "\n";
+		return passed;
+	}
+}
+
+bool TestCubeBatch()
+{
+	bool passed = true;
+	unsigned int seed = 1;
+
+	for (auto numStickersEdge : { 1u, 2u, 3u, 4u, 5u, 7u, 8u, 13u, 64u }) {
+		for (auto numCubes : { static_cast<size_t>(1u), static_cast<size_t>(37u) }) {
+			passed &= TestBatch(numStickersEdge, numCubes, seed++);
+		}
+	}
+
+	// Rows long enough to be shifted and gathered by the worker pool
+	for (auto numStickersEdge : { 3u, 8u }) {
+		passed &= TestBatch(numStickersEdge, PARALLEL_NUM_CUBES, seed++);
+	}
+
+	std::cout << (passed ? "All batches match single cubes\n" : "Some batches differ from single cubes\n");
+	return passed;
+}
\ No newline at end of file
@@ -0,0 +1,267 @@
+#include "CoreTests.h"
+
+#include "MoveLogReader.h"
+#include "MoveLogWriter.h"
+#include "RubikCube.h"
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+#include <cstdio>
+
+// Round trips of the binary save file (RCSS), the text export and the binary move log (RCML)
+// Every file is written, read back and compared, then damaged copies of it must be rejected
+
+namespace {
+
+	const char* const TEMPORARY_FILE = "RubikCubeCoreTests.tmp";
+
+	const unsigned int NUM_SCRAMBLE_MOVES = 200u;
+
+	// Enough moves with varint layers to span several chunks of MoveLogReader
+	const unsigned int NUM_LOG_MOVES = 300000u;
+
+	// Not a divisor of the number of moves, so the last batch is partial
+	const size_t LOG_BATCH_SIZE = 4093u;
+
+	std::vector<uint8_t> ReadFile(const std::string& filepath)
+	{
+		std::ifstream file(filepath, std::ifstream::in | std::ifstream::binary);
+		return std::vector<uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+	}
+
+	void WriteFile(const std::string& filepath, const std::vector<uint8_t>& content)
+	{
+		std::ofstream file(filepath, std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+		file.write(reinterpret_cast<const char*>(content.data()), content.size());
+	}
+
+	bool Throws(const std::function<void()>& function)
+	{
+		try {
+			function();
+		}
+		catch (const std::exception&) {
+			return true;
+		}
+		return false;
+	}
+
+	// Near, far and varint layers of the move log are all picked often
+	MoveTable::Move RandomMove(std::mt19937& random, unsigned int numStickersEdge)
+	{
+		auto axis = static_cast<MoveTable::Axis>(random() % MoveTable::NUM_AXES);
+		auto n = numStickersEdge;
+		auto offset = static_cast<unsigned int>(random() % 20u);
+		unsigned int layer;
+
+		switch (random() % 3u) {
+		case 0: layer = std::min(n - 1u, offset); break;
+		case 1: layer = n - 1u - std::min(n - 1u, offset); break;
+		default: layer = static_cast<unsigned int>(random() % n); break;
+		}
+		return { axis, layer, (random() & 1u) != 0 };
+	}
+
+	std::vector<uint8_t> ReadStickers(const RubikCube& cube)
+	{
+		auto& stickers = cube.GetSnapshot()->GetStickers();
+		std::vector<uint8_t> result(stickers.Size());
+		stickers.Read(result.data());
+		return result;
+	}
+
+	// Description of the first failure, empty if the cube came back the same
+	std::string TestCubeFile(const RubikCube& cube, bool binary)
+	{
+		if (binary) {
+			cube.SaveIntoFile(TEMPORARY_FILE);
+		}
+		else {
+			cube.ExportIntoTextFile(TEMPORARY_FILE);
+		}
+
+		RubikCube loaded(TEMPORARY_FILE);
+
+		if (loaded.GetNumStickersPerEdge() != cube.GetNumStickersPerEdge() || ReadStickers(loaded) != ReadStickers(cube)) {
+			return "loaded stickers differ";
+		}
+		if (loaded.Hash() != cube.Hash()) {
+			return "loaded hash differs";
+		}
+
+		// The checksum covers the stickers, the last one is changed to another color
+		if (binary) {
+			auto content = ReadFile(TEMPORARY_FILE);
+			content.back() = static_cast<uint8_t>((content.back() + 1u) % StickerColor::NUM_COLORS);
+			WriteFile(TEMPORARY_FILE, content);
+
+			if (!Throws([]() { RubikCube damaged(TEMPORARY_FILE); })) {
+				return "damaged save file was loaded";
+			}
+		}
+		return std::string();
+	}
+
+	bool TestCubeFiles(unsigned int numStickersEdge, unsigned int seed)
+	{
+		std::mt19937 random(seed);
+		RubikCube cube(numStickersEdge);
+		std::vector<MoveTable::Move> moves;
+
+		for (auto i = 0u; i < NUM_SCRAMBLE_MOVES; i++) {
+			moves.push_back(RandomMove(random, numStickersEdge));
+		}
+		cube.ApplyMoves(moves);
+
+		auto failure = TestCubeFile(cube, true);
+
+		if (failure.empty()) {
+			failure = TestCubeFile(cube, false);
+		}
+		std::remove(TEMPORARY_FILE);
+
+		std::cout << (failure.empty() ? "ok   " : "FAIL ") << numStickersEdge << "x" << numStickersEdge << "x"
+			<< numStickersEdge << " save file and export";
+
+		if (!failure.empty()) {
+			std::cout << ": " << failure;
+		}
+		std::cout << "\n";
+		return failure.empty();
+	}
+
+	std::vector<MoveTable::Move> ReadMoveLog(MoveLogReader& reader)
+	{
+		std::vector<MoveTable::Move> moves;
+		std::vector<MoveTable::Move> batch;
+
+		while (reader.ReadMoves(batch, LOG_BATCH_SIZE)) {
+			moves.insert(moves.end(), batch.begin(), batch.end());
+		}
+		return moves;
+	}
+
+	bool Equal(const std::vector<MoveTable::Move>& a, const std::vector<MoveTable::Move>& b)
+	{
+		return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](const MoveTable::Move& x, const MoveTable::Move& y) {
+			return x.axis == y.axis && x.layer == y.layer && x.clockwise == y.clockwise;
+		});
+	}
+
+	std::string TestMoveLog(unsigned int numStickersEdge, bool checksumEnabled, const std::vector<MoveTable::Move>& moves)
+	{
+		{
+			MoveLogWriter writer(TEMPORARY_FILE, numStickersEdge, checksumEnabled);
+
+			for (auto& move : moves) {
+				writer.Write(move);
+			}
+			writer.Close();
+		}
+
+		MoveLogReader reader(TEMPORARY_FILE);
+
+		if (reader.NumStickersEdge() != numStickersEdge || reader.NumMoves() != moves.size()) {
+			return "header differs";
+		}
+		if (!Equal(ReadMoveLog(reader), moves)) {
+			return "moves read back differ";
+		}
+
+		auto content = ReadFile(TEMPORARY_FILE);
+
+		// A log cut short is detected with or without the checksum
+		WriteFile(TEMPORARY_FILE, std::vector<uint8_t>(content.begin(), content.end() - 1));
+
+		if (!Throws([]() { MoveLogReader truncated(TEMPORARY_FILE); ReadMoveLog(truncated); })) {
+			return "truncated log was read";
+		}
+
+		// The direction bit of the last move is flipped, only the checksum can tell
+		if (checksumEnabled) {
+			auto damaged = content;
+			auto lastMove = MoveLogFormat::HEADER_SIZE;
+
+			for (size_t i = 0; i + 1 < moves.size(); i++) {
+				uint8_t bytes[MoveLogFormat::MAX_MOVE_SIZE];
+				lastMove += MoveLogFormat::EncodeMove(moves[i], numStickersEdge, bytes);
+			}
+			damaged[lastMove] ^= 4u;
+			WriteFile(TEMPORARY_FILE, damaged);
+
+			if (!Throws([]() { MoveLogReader corrupted(TEMPORARY_FILE); ReadMoveLog(corrupted); })) {
+				return "damaged log was read";
+			}
+		}
+
+		// The writer is dropped without Close(), as if the program stopped while saving
+		{
+			MoveLogWriter writer(TEMPORARY_FILE, numStickersEdge, checksumEnabled);
+
+			for (auto& move : moves) {
+				writer.Write(move);
+			}
+		}
+		if (!Throws([]() { MoveLogReader incomplete(TEMPORARY_FILE); })) {
+			return "incomplete log was read";
+		}
+		return std::string();
+	}
+
+	bool TestMoveLogs(unsigned int numStickersEdge, unsigned int seed)
+	{
+		std::mt19937 random(seed);
+		std::vector<MoveTable::Move> moves;
+
+		for (auto i = 0u; i < NUM_LOG_MOVES; i++) {
+			moves.push_back(RandomMove(random, numStickersEdge));
+		}
+
+		auto failure = TestMoveLog(numStickersEdge, true, moves);
+
+		if (failure.empty()) {
+			failure = TestMoveLog(numStickersEdge, false, moves);
+		}
+		std::remove(TEMPORARY_FILE);
+
+		std::cout << (failure.empty() ? "ok   " : "FAIL ") << numStickersEdge << "x" << numStickersEdge << "x"
+			<< numStickersEdge << " move log";
+
+		if (!failure.empty()) {
+			std::cout << ": " << failure;
+		}
+		std::cout << "\n";
+		return failure.empty();
+	}
+}
+
+bool TestFileFormats()
+{
+	bool passed = true;
+	unsigned int seed = 1;
+
+	// Fixed, byte and packed storages are saved from their own layouts
+	for (auto numStickersEdge : { 1u, 2u, 3u, 7u, 8u, 100u, 511u, 512u, 1000u }) {
+		passed &= TestCubeFiles(numStickersEdge, seed++);
+	}
+
+	// Sparse cubes do not have all stickers at once
+	bool sparseRejected = Throws([]() { RubikCube(1001u).SaveIntoFile(TEMPORARY_FILE); });
+	std::remove(TEMPORARY_FILE);
+	std::cout << (sparseRejected ? "ok   " : "FAIL ") << "1001x1001x1001 save file is refused\n";
+	passed &= sparseRejected;
+
+	// Layers up to 15 from either outer layer fit the move byte, the rest are varints of 1 to 5 bytes
+	for (auto numStickersEdge : { 1u, 2u, 3u, 16u, 17u, 31u, 32u, 47u, 1000u, 1000000u }) {
+		passed &= TestMoveLogs(numStickersEdge, seed++);
+	}
+
+	std::cout << (passed ? "All files are read back as written\n" : "Some files are not read back as written\n");
+	return passed;
+}
\ No newline at end of file
@@ -0,0 +1,15 @@
+#include "CoreTests.h"
+
+#include <iostream>
+#include <cstdlib>
+
+int main()
+{
+	// All tests run even if one of them fails
+	bool passed = TestCubeBatch();
+	passed &= TestStickerStorage();
+	passed &= TestFileFormats();
+
+	std::cout << (passed ? "All tests passed\n" : "Some tests failed\n");
+	return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
\ No newline at end of file
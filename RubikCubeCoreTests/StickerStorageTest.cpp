@@ -0,0 +1,275 @@
+#include "CoreTests.h"
+
+#include "RubikCube.h"
+#include "ZobristHash.h"
+
+#include <algorithm>
+#include <array>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+// Differential test of RubikCube against the sticker model of the original implementation
+// Levels are picked on both sides of every storage threshold (fixed, byte, packed, sparse, run hashing),
+// the same random moves are performed by both, then stickers, run lengths, equal rows and the hash are compared
+
+namespace {
+
+	const unsigned int NUM_MOVES = 300u;
+
+	// Moves performed through Rotate() and Update() instead of ApplyMoves()
+	const unsigned int NUM_ANIMATED_MOVES = 20u;
+
+	// Colors of faces of the solved cube in the order of RubikCube::FaceIndex
+	const uint8_t SOLVED_FACE_COLORS[StickerBuffer::NUM_FACES] = {
+		StickerColor::WHITE,
+		StickerColor::YELLOW,
+		StickerColor::GREEN,
+		StickerColor::BLUE,
+		StickerColor::RED,
+		StickerColor::ORANGE
+	};
+
+	// Faces are vectors of rows as in the original RubikCube, moves are its SwapFaces*AxisRotation
+	class ReferenceCube final {
+	private:
+
+		typedef std::vector<std::vector<uint8_t>> Face;
+
+		unsigned int m_numStickersEdge;
+		std::array<Face, StickerBuffer::NUM_FACES> m_faces;
+
+		static void ShiftStickerColors(uint8_t& c1, uint8_t& c2, uint8_t& c3, uint8_t& c4)
+		{
+			auto tmp = c1;
+			c1 = c2;
+			c2 = c3;
+			c3 = c4;
+			c4 = tmp;
+		}
+
+		void RotateFace(unsigned int face, bool clockwise)
+		{
+			auto n = m_numStickersEdge;
+			auto& f = m_faces[face];
+
+			for (auto i = 0u; i < n / 2; i++) {
+				for (auto j = i; j < n - i - 1; j++) {
+					auto& secondRow = clockwise ? f[n - i - 1][j] : f[i][n - j - 1];
+					auto& fourthRow = clockwise ? f[i][n - j - 1] : f[n - i - 1][j];
+					ShiftStickerColors(f[j][i], secondRow, f[n - j - 1][n - i - 1], fourthRow);
+				}
+			}
+		}
+
+	public:
+
+		explicit ReferenceCube(unsigned int numStickersEdge) : m_numStickersEdge(numStickersEdge)
+		{
+			for (auto face = 0u; face < StickerBuffer::NUM_FACES; face++) {
+				m_faces[face].assign(numStickersEdge, std::vector<uint8_t>(numStickersEdge, SOLVED_FACE_COLORS[face]));
+			}
+		}
+
+		uint8_t Get(unsigned int face, unsigned int x, unsigned int y) const { return m_faces[face][x][y]; }
+
+		void Rotate(const MoveTable::Move& move)
+		{
+			auto n = m_numStickersEdge;
+			auto i = move.layer;
+			auto cw = move.clockwise;
+			auto& f = m_faces;
+
+			switch (move.axis) {
+			case MoveTable::X_AXIS:
+				if (i == 0) {
+					RotateFace(RubikCube::LEFT, !cw);
+				}
+				else if (i == n - 1) {
+					RotateFace(RubikCube::RIGHT, cw);
+				}
+				for (auto y = 0u; y < n; y++) {
+					auto& second = cw ? f[RubikCube::BACK][i][y] : f[RubikCube::FRONT][i][y];
+					auto& fourth = cw ? f[RubikCube::FRONT][i][y] : f[RubikCube::BACK][i][y];
+					ShiftStickerColors(f[RubikCube::TOP][i][y], second, f[RubikCube::BOTTOM][i][y], fourth);
+				}
+				break;
+			case MoveTable::Y_AXIS:
+				if (i == 0) {
+					RotateFace(RubikCube::BOTTOM, !cw);
+				}
+				else if (i == n - 1) {
+					RotateFace(RubikCube::TOP, cw);
+				}
+				for (auto x = 0u; x < n; x++) {
+					auto& left = f[RubikCube::LEFT][i][x];
+					auto& right = f[RubikCube::RIGHT][n - i - 1][n - x - 1];
+					auto& second = cw ? left : right;
+					auto& fourth = cw ? right : left;
+					ShiftStickerColors(f[RubikCube::FRONT][x][n - i - 1], second, f[RubikCube::BACK][n - x - 1][i], fourth);
+				}
+				break;
+			default:
+				if (i == 0) {
+					RotateFace(RubikCube::BACK, !cw);
+				}
+				else if (i == n - 1) {
+					RotateFace(RubikCube::FRONT, cw);
+				}
+				for (auto x = 0u; x < n; x++) {
+					auto& second = cw ? f[RubikCube::RIGHT][x][i] : f[RubikCube::LEFT][x][i];
+					auto& fourth = cw ? f[RubikCube::LEFT][x][i] : f[RubikCube::RIGHT][x][i];
+					ShiftStickerColors(f[RubikCube::TOP][x][i], second, f[RubikCube::BOTTOM][n - x - 1][n - i - 1], fourth);
+				}
+				break;
+			}
+		}
+
+		// Face by face, row by row as StickerStorage::Read
+		std::vector<uint8_t> Stickers() const
+		{
+			std::vector<uint8_t> stickers;
+			stickers.reserve(6u * static_cast<size_t>(m_numStickersEdge) * m_numStickersEdge);
+
+			for (auto& face : m_faces) {
+				for (auto& row : face) {
+					stickers.insert(stickers.end(), row.begin(), row.end());
+				}
+			}
+			return stickers;
+		}
+	};
+
+	// Outer and nearby layers are picked often, they take the special paths of storages and move logs
+	MoveTable::Move RandomMove(std::mt19937& random, unsigned int numStickersEdge)
+	{
+		auto axis = static_cast<MoveTable::Axis>(random() % MoveTable::NUM_AXES);
+		auto n = numStickersEdge;
+		unsigned int layer;
+
+		switch (random() % 4u) {
+		case 0: layer = 0; break;
+		case 1: layer = n - 1u; break;
+		case 2: layer = std::min(n - 1u, static_cast<unsigned int>(random() % 3u)); break;
+		default: layer = static_cast<unsigned int>(random() % n); break;
+		}
+		return { axis, layer, (random() & 1u) != 0 };
+	}
+
+	// Description of the first difference, empty if the cube matches the reference
+	std::string Compare(const RubikCube& cube, const ReferenceCube& reference)
+	{
+		auto n = cube.GetNumStickersPerEdge();
+		auto snapshot = cube.GetSnapshot();
+		auto expected = reference.Stickers();
+
+		std::vector<uint8_t> stickers(expected.size());
+		snapshot->GetStickers().Read(stickers.data());
+
+		if (stickers != expected) {
+			return "snapshot stickers differ";
+		}
+
+		ZobristHash hash;
+		hash.Reset(n, SOLVED_FACE_COLORS, expected.data());
+
+		if (cube.Hash() != hash.Value() || snapshot->Hash() != hash.Value()) {
+			return "hash differs from the hash of all stickers";
+		}
+
+		for (auto face = 0u; face < StickerBuffer::NUM_FACES; face++) {
+			auto faceIndex = static_cast<RubikCube::FaceIndex>(face);
+
+			for (auto x = 0u; x < n; x++) {
+				for (auto y = 0u; y < n;) {
+					auto color = reference.Get(face, x, y);
+
+					if (cube.GetSticker(faceIndex, x, y) != color || snapshot->GetSticker(faceIndex, x, y) != color) {
+						return "sticker differs";
+					}
+					auto length = snapshot->GetStickerRunLength(faceIndex, x, y, n);
+
+					if (length == 0 || length > n - y) {
+						return "run length is out of the row";
+					}
+					for (auto end = y + length; y < end; y++) {
+						if (reference.Get(face, x, y) != color) {
+							return "run has stickers of another color";
+						}
+					}
+				}
+
+				auto numEqualRows = snapshot->GetEqualRows(faceIndex, x, n);
+
+				if (numEqualRows == 0 || numEqualRows > n - x) {
+					return "equal rows are out of the face";
+				}
+				for (auto r = 1u; r < numEqualRows; r++) {
+					for (auto y = 0u; y < n; y++) {
+						if (reference.Get(face, x + r, y) != reference.Get(face, x, y)) {
+							return "rows reported equal differ";
+						}
+					}
+				}
+			}
+		}
+		return std::string();
+	}
+
+	bool TestLevel(unsigned int numStickersEdge, unsigned int seed)
+	{
+		std::mt19937 random(seed);
+		RubikCube cube(numStickersEdge);
+		ReferenceCube reference(numStickersEdge);
+
+		// Animated moves first, some of them wait in the queue of pending moves
+		for (auto i = 0u; i < NUM_ANIMATED_MOVES; i++) {
+			auto move = RandomMove(random, numStickersEdge);
+			cube.Rotate(static_cast<RubikCube::RotationType>(move.axis), move.layer, move.clockwise);
+			reference.Rotate(move);
+
+			if (i % 3u == 2u) {
+				while (!cube.IsIdle()) {
+					cube.Update(1.f);
+				}
+			}
+		}
+		while (!cube.IsIdle()) {
+			cube.Update(1.f);
+		}
+
+		std::vector<MoveTable::Move> moves;
+
+		for (auto i = 0u; i < NUM_MOVES; i++) {
+			moves.push_back(RandomMove(random, numStickersEdge));
+			reference.Rotate(moves.back());
+		}
+		cube.ApplyMoves(moves);
+
+		auto difference = Compare(cube, reference);
+
+		std::cout << (difference.empty() ? "ok   " : "FAIL ") << numStickersEdge << "x" << numStickersEdge << "x"
+			<< numStickersEdge << " stickers";
+
+		if (!difference.empty()) {
+			std::cout << ": " << difference;
+		}
+		std::cout << "\n";
+		return difference.empty();
+	}
+}
+
+bool TestStickerStorage()
+{
+	bool passed = true;
+	unsigned int seed = 1;
+
+	// Fixed up to 7, bytes up to 511, packed up to 1000, sparse above, hashed by runs from 1024
+	for (auto numStickersEdge : { 1u, 2u, 3u, 7u, 8u, 9u, 511u, 512u, 513u, 1000u, 1001u, 1023u, 1024u, 1100u }) {
+		passed &= TestLevel(numStickersEdge, seed++);
+	}
+
+	std::cout << (passed ? "All storages match the reference cube\n" : "Some storages differ from the reference cube\n");
+	return passed;
+}
\ No newline at end of file
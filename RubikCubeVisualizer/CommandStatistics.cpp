@@ -0,0 +1,54 @@
+#include "CommandStatistics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+
+CommandStatistics::CommandStatistics()
+	: m_numMoves(0),
+	m_numErrors(0)
+{
+}
+
+void CommandStatistics::AddCommand(const std::string& command, double seconds, bool failed)
+{
+	m_latencies[command].push_back(seconds);
+
+	if (failed) {
+		m_numErrors++;
+	}
+}
+
+double CommandStatistics::Percentile(const std::vector<double>& sortedLatencies, double fraction)
+{
+	auto rank = static_cast<size_t>(std::ceil(fraction * sortedLatencies.size()));
+	return sortedLatencies[std::max<size_t>(rank, 1u) - 1u];
+}
+
+void CommandStatistics::Print(std::ostream& output, double wallSeconds)
+{
+	size_t numCommands = 0;
+
+	for (auto& latencies : m_latencies) {
+		numCommands += latencies.second.size();
+	}
+
+	output << "\n" << numCommands << " commands (" << m_numErrors << " failed) in " << wallSeconds << " s, "
+		<< m_numMoves << " moves (" << m_numMoves / std::max(wallSeconds, 1e-9) << " moves/s)\n\n";
+
+	output << std::left << std::setw(24) << "command" << std::right << std::setw(8) << "count"
+		<< std::setw(12) << "p50 ms" << std::setw(12) << "p90 ms" << std::setw(12) << "p99 ms" << std::setw(12) << "max ms" << "\n";
+	output << std::fixed << std::setprecision(3);
+
+	for (auto& latencies : m_latencies) {
+		auto& sorted = latencies.second;
+		std::sort(sorted.begin(), sorted.end());
+
+		output << std::left << std::setw(24) << latencies.first << std::right << std::setw(8) << sorted.size()
+			<< std::setw(12) << Percentile(sorted, .5) * 1000.
+			<< std::setw(12) << Percentile(sorted, .9) * 1000.
+			<< std::setw(12) << Percentile(sorted, .99) * 1000.
+			<< std::setw(12) << sorted.back() * 1000. << "\n";
+	}
+	output << std::defaultfloat;
+}
\ No newline at end of file
@@ -0,0 +1,33 @@
+#ifndef COMMAND_STATISTICS_H
+#define COMMAND_STATISTICS_H
+
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// Latencies of control commands and the number of moves they performed, reported when a script ends
+class CommandStatistics final {
+private:
+
+	// Latencies in seconds by command name
+	std::map<std::string, std::vector<double>> m_latencies;
+	uint64_t m_numMoves;
+	size_t m_numErrors;
+
+	// Latency below which the fraction of sorted latencies is, nearest rank
+	static double Percentile(const std::vector<double>& sortedLatencies, double fraction);
+
+public:
+
+	CommandStatistics();
+
+	void AddCommand(const std::string& command, double seconds, bool failed);
+	void AddMoves(uint64_t numMoves) { m_numMoves += numMoves; }
+
+	// Wall time, moves per second and latency percentiles of every command
+	void Print(std::ostream& output, double wallSeconds);
+};
+
+#endif
\ No newline at end of file
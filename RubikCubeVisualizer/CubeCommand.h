@@ -0,0 +1,61 @@
+#ifndef CUBE_COMMAND_H
+#define CUBE_COMMAND_H
+
+#include "RubikCube.h"
+#include <memory>
+#include <vector>
+
+// Command parsed on the control thread and performed on the render thread
+// Anything expensive (reading files, building cubes, parsing sequences) is done before it is sent
+struct CubeCommand {
+	enum Type {
+		NONE,
+		ROTATE,
+		// Take over the state of the prepared cube (new cube, reset, load)
+		REPLACE_CUBE,
+		APPLY_MOVES,
+		SET_MAX_PENDING_MOVES
+	};
+
+	Type type;
+	MoveTable::Move move;
+	std::shared_ptr<RubikCube> cube;
+	std::shared_ptr<const std::vector<MoveTable::Move>> moves;
+	size_t maxPendingMoves;
+
+	CubeCommand() : type(NONE), move{ MoveTable::X_AXIS, 0, false }, maxPendingMoves(0) {}
+
+	static CubeCommand Rotate(const MoveTable::Move& move)
+	{
+		CubeCommand command;
+		command.type = ROTATE;
+		command.move = move;
+		return command;
+	}
+
+	static CubeCommand ReplaceCube(const std::shared_ptr<RubikCube>& cube)
+	{
+		CubeCommand command;
+		command.type = REPLACE_CUBE;
+		command.cube = cube;
+		return command;
+	}
+
+	static CubeCommand ApplyMoves(const std::shared_ptr<const std::vector<MoveTable::Move>>& moves)
+	{
+		CubeCommand command;
+		command.type = APPLY_MOVES;
+		command.moves = moves;
+		return command;
+	}
+
+	static CubeCommand SetMaxPendingMoves(size_t maxPendingMoves)
+	{
+		CubeCommand command;
+		command.type = SET_MAX_PENDING_MOVES;
+		command.maxPendingMoves = maxPendingMoves;
+		return command;
+	}
+};
+
+#endif
\ No newline at end of file
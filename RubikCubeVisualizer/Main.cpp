@@ -1,8 +1,10 @@
 #include "ShaderProgram.h"
 #include "LightShaderUniforms.h"
 #include "RubikCubeControl.h"
+#include "RubikCubeRenderer.h"
 
 #include <memory>
+#include <string>
 #include <thread>
 #include <iostream>
 #include <glm/gtc/type_ptr.hpp>
@@ -16,8 +18,13 @@ namespace {
 
 	int glutWindow;
 
+	// Command line options
+	std::string scriptPath;
+	bool headless = false;
+
 	std::unique_ptr<ShaderProgram> shader;
 	std::shared_ptr<RubikCube> rubikCube;
+	std::unique_ptr<RubikCubeRenderer> rubikCubeRenderer;
 	std::unique_ptr<RubikCubeControl> rubikCubeControl;
 	Camera camera(1.f * WINDOW_WIDTH, 1.f * WINDOW_HEIGHT);
 
@@ -70,8 +77,9 @@ namespace {
 			shader = std::make_unique<ShaderProgram>("VertexShader.glsl", "FragmentShader.glsl");
 			InitializeShaderVariables();
 
-			rubikCube = std::make_shared<RubikCube>(positionAttribute, normalAttribute, 3);
-			rubikCubeControl = std::make_unique<RubikCubeControl>(rubikCube);
+			rubikCube = std::make_shared<RubikCube>(3);
+			rubikCubeRenderer = std::make_unique<RubikCubeRenderer>(positionAttribute, normalAttribute);
+			rubikCubeControl = std::make_unique<RubikCubeControl>(rubikCube, scriptPath);
 		}
 		catch (const std::exception& ex) {
 			std::cout << "Exception catch: " << ex.what() << std::endl;
@@ -85,6 +93,7 @@ namespace {
 	{
 		// Must be called before OpenGL destroys it's own content
 		rubikCubeControl.reset();
+		rubikCubeRenderer.reset();
 		rubikCube.reset();
 		shader.reset();
 		glutDestroyWindow(glutWindow);
@@ -111,6 +120,8 @@ namespace {
 			exit(0);
 		}
 
+		rubikCubeControl->PerformPendingCommands();
+
 		// FYI delta time is overkill for this simple animation
 		rubikCube->Update(1.f / DELTA_TIME);
 	}
@@ -126,7 +137,7 @@ namespace {
 		shader->SetActive();
 		SetupLight();
 		SetupEyePosition();
-		rubikCube->Draw(camera, matrixUniforms, materialUniforms);
+		rubikCubeRenderer->Draw(*rubikCube, camera, matrixUniforms, materialUniforms);
 		shader->SetInactive();
 
 		glutSwapBuffers();
@@ -229,6 +240,40 @@ namespace {
 		std::cout << message << std::endl;
 	}
 
+	// --script [filename] reads commands from the file, --headless runs them without a window
+	bool ParseArguments(int argc, char** argv)
+	{
+		for (int i = 1; i < argc; i++) {
+			std::string argument = argv[i];
+
+			if (argument == "--script" && i + 1 < argc) {
+				scriptPath = argv[++i];
+			}
+			else if (argument == "--headless") {
+				headless = true;
+			}
+			else {
+				std::cout << "Usage: " << argv[0] << " [--script filename] [--headless]\n";
+				return false;
+			}
+		}
+		return true;
+	}
+
+	int RunHeadless()
+	{
+		try {
+			rubikCube = std::make_shared<RubikCube>(3);
+			rubikCubeControl = std::make_unique<RubikCubeControl>(rubikCube, scriptPath, true);
+			rubikCubeControl->Run();
+		}
+		catch (const std::exception& ex) {
+			std::cout << "Exception catch: " << ex.what() << std::endl;
+			return EXIT_FAILURE;
+		}
+		return 0;
+	}
+
 	void SetupOpenGLCallback()
 	{
 		auto debugExtAddr = wglGetProcAddress("glDebugMessageCallbackARB");
@@ -244,6 +289,13 @@ namespace {
 
 int main(int argc, char** argv)
 {
+	if (!ParseArguments(argc, argv)) {
+		return EXIT_FAILURE;
+	}
+	if (headless) {
+		return RunHeadless();
+	}
+
 	glutInit(&argc, argv);
 	glutInitDisplayMode(GLUT_DEPTH | GLUT_DOUBLE | GLUT_RGBA);
 	glutSetOption(GLUT_ACTION_ON_WINDOW_CLOSE, GLUT_ACTION_GLUTMAINLOOP_RETURNS);
@@ -1,97 +1,272 @@
 #include "RubikCubeControl.h"
+#include "CubeNotation.h"
+#include "MoveLogReader.h"
+#include "MoveLogWriter.h"
+#include "RotationLogReader.h"
 
 #include <iostream>
 #include <fstream>
 #include <string>
-#include <sstream>
 #include <algorithm>
+#include <chrono>
+#include <vector>
 
-RubikCubeControl::RubikCubeControl(const std::shared_ptr<RubikCube>& rubikCube)
+RubikCubeControl::RubikCubeControl(const std::shared_ptr<RubikCube>& rubikCube, const std::string& scriptPath,
+	bool headless)
 	: m_rubikCube(rubikCube),
-	m_running(true)
+	m_numStickersEdge(rubikCube->GetNumStickersPerEdge()),
+	m_running(true),
+	m_headless(headless),
+	m_input(&std::cin),
+	m_moveQueueFullReported(false)
 {
-	m_thread = std::thread([this]() {
-		std::cout << "Welcome to the Rubik's Cube Control Center!\n\n";
-		std::cout << "Write help to show available commands.\n\n";
-		
-		while (m_running) {
-			std::cout << "> ";
-			HandleCommand();
+	if (!scriptPath.empty()) {
+		m_script.open(scriptPath);
+
+		if (!m_script.good()) {
+			throw std::runtime_error("Unable to open script " + scriptPath);
 		}
-	});
+		m_input = &m_script;
+	}
+
+	if (!m_headless) {
+		m_thread = std::thread([this]() {
+			Run();
+		});
+	}
 }
 
 RubikCubeControl::~RubikCubeControl()
 {
-	m_thread.detach();
+	if (m_thread.joinable()) {
+		m_thread.detach();
+	}
+}
+
+void RubikCubeControl::Run()
+{
+	if (m_script.is_open()) {
+		std::cout << "Running script" << (m_headless ? " without rendering" : "") << "\n\n";
+	}
+	else {
+		std::cout << "Welcome to the Rubik's Cube Control Center!\n\n";
+		std::cout << "Write help to show available commands.\n\n";
+	}
+	auto startTime = std::chrono::steady_clock::now();
+
+	while (HandleCommand()) {
+	}
+
+	if (m_script.is_open()) {
+		m_statistics.Print(std::cout, std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count());
+	}
+	m_running = false;
 }
 
-void RubikCubeControl::HandleCommand()
+bool RubikCubeControl::HandleCommand()
 {
 	std::string command;
-	std::cin >> command;
+
+	if (!m_script.is_open()) {
+		std::cout << "> ";
+	}
+	if (!(*m_input >> command) || command == "quit") {
+		return false;
+	}
+
+	auto startTime = std::chrono::steady_clock::now();
+	bool failed = false;
 
 	try {
-		if (command == "quit") {
-			m_running = false;
-		}
-		else if (command == "help") {
-			PrintHelp();
-		}
-		else if (command == "rotate") {
-			if (m_rubikCube->IsRotating()) {
-				std::cout << "Error: Rubik cube is rotating\n";
-			}
-			else {
-				std::getline(std::cin, command);
-				Rotate(command);
-				std::cout << "Rotation performed\n";
-			}
-		}
-		else if (command == "undo") {
-			UndoRotation();
-			std::cout << "Undo performed\n";
-		}
-		else if (command == "reset") {
-			m_rubikCube->NewCube(m_rubikCube->GetNumStickersPerEdge());
-			m_rotationHistory.clear();
-			std::cout << "Cube was reset\n";
-		}
-		else if (command == "new_cube") {
-			unsigned int numStickers;
-			std::cin >> numStickers;
-			m_rubikCube->NewCube(numStickers);
-			m_rotationHistory.clear();
-			std::cout << "Cube created\n";
+		PerformCommand(command);
+	}
+	catch (const std::exception& ex) {
+		std::cout << "Error: " << ex.what() << std::endl;
+		failed = true;
+	}
+
+	if (m_script.is_open()) {
+		// Latency includes performing the command by the render thread together with its animation,
+		// so moves per second count performed rotations, not queued ones
+		WaitUntilPerformed();
+		auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+		m_statistics.AddCommand(command, seconds, failed);
+	}
+	return true;
+}
+
+void RubikCubeControl::PerformCommand(const std::string& command)
+{
+	auto& input = *m_input;
+	std::string argument;
+
+	if (command == "help") {
+		PrintHelp();
+	}
+	else if (command == "rotate") {
+		std::getline(input, argument);
+		Rotate(argument);
+		std::cout << "Rotation queued\n";
+	}
+	else if (command == "undo") {
+		UndoRotation();
+		std::cout << "Undo performed\n";
+	}
+	else if (command == "redo") {
+		RedoRotation();
+		std::cout << "Redo performed\n";
+	}
+	else if (command == "history_depth") {
+		size_t depth;
+		input >> depth;
+
+		if (input.fail()) {
+			input.clear();
+			throw std::runtime_error("Invalid history depth");
 		}
-		else if (command == "save") {
-			std::cin >> command; // get filename
-			m_rubikCube->SaveIntoFile(command);
-			std::cout << "Cube saved\n";
+		m_history.SetDepth(depth);
+		std::cout << "History depth set\n";
+	}
+	else if (command == "history_spill") {
+		input >> argument; // get filename
+		SetHistorySpillFile(argument);
+	}
+	else if (command == "queue_depth") {
+		unsigned int maxPendingMoves;
+		input >> maxPendingMoves;
+
+		if (input.fail()) {
+			input.clear();
+			throw std::runtime_error("Invalid queue depth");
 		}
-		else if (command == "load") {
-			std::cin >> command; // get filename
-			m_rubikCube->LoadFromFile(command);
-			m_rotationHistory.clear();
-			std::cout << "Cube loaded\n";
+		Send(CubeCommand::SetMaxPendingMoves(maxPendingMoves));
+		std::cout << "Queue depth set\n";
+	}
+	else if (command == "reset") {
+		Send(CubeCommand::ReplaceCube(std::make_shared<RubikCube>(m_numStickersEdge)));
+		m_history.Clear();
+		std::cout << "Cube was reset\n";
+	}
+	else if (command == "new_cube") {
+		unsigned int numStickers;
+		input >> numStickers;
+
+		if (input.fail()) {
+			input.clear();
+			throw std::runtime_error("Invalid number of stickers");
 		}
-		else if (command == "save_rotations") {
-			std::cin >> command; // get filename
-			SaveRotations(command);
-			std::cout << "Rotations saved\n";
+		Send(CubeCommand::ReplaceCube(std::make_shared<RubikCube>(numStickers)));
+		m_numStickersEdge = numStickers;
+		m_history.Clear();
+		std::cout << "Cube created\n";
+	}
+	else if (command == "save") {
+		input >> argument; // get filename
+		WaitUntilPerformed();
+		m_rubikCube->SaveIntoFile(argument);
+		std::cout << "Cube saved\n";
+	}
+	else if (command == "export") {
+		input >> argument; // get filename
+		WaitUntilPerformed();
+		m_rubikCube->ExportIntoTextFile(argument);
+		std::cout << "Cube exported\n";
+	}
+	else if (command == "load") {
+		input >> argument; // get filename
+		auto cube = std::make_shared<RubikCube>(argument);
+		m_numStickersEdge = cube->GetNumStickersPerEdge();
+		Send(CubeCommand::ReplaceCube(cube));
+		m_history.Clear();
+		std::cout << "Cube loaded\n";
+	}
+	else if (command == "save_rotations") {
+		input >> argument; // get filename
+		SaveRotations(argument);
+		std::cout << "Rotations saved\n";
+	}
+	else if (command == "save_rotations_binary") {
+		input >> argument; // get filename
+		SaveRotationsBinary(argument);
+		std::cout << "Rotations saved\n";
+	}
+	else if (command == "load_rotations") {
+		input >> argument; // get filename
+		LoadAndPerformRotations(argument);
+		std::cout << "Rotations loaded and performed\n";
+	}
+	else {
+		throw std::runtime_error("Unknown command. Type help for available commands.");
+	}
+}
+
+void RubikCubeControl::Send(CubeCommand&& command)
+{
+	// Back-pressure, the render thread frees one slot per performed command
+	while (!m_commands.TryPush(std::move(command))) {
+		std::this_thread::yield();
+	}
+
+	if (m_headless) {
+		PerformPendingCommands();
+	}
+}
+
+void RubikCubeControl::SendRotations(const std::vector<MoveTable::Move>& moves)
+{
+	if (m_headless) {
+		Send(CubeCommand::ApplyMoves(std::make_shared<std::vector<MoveTable::Move>>(moves)));
+	}
+	else {
+		for (auto& move : moves) {
+			Send(CubeCommand::Rotate(move));
 		}
-		else if (command == "load_rotations") {
-			std::cin >> command; // get filename
-			LoadAndPerformRotations(command);
-			m_rotationHistory.clear();
-			std::cout << "Rotations loaded and performed\n";
+	}
+	m_statistics.AddMoves(moves.size());
+}
+
+void RubikCubeControl::WaitUntilPerformed()
+{
+	// The snapshot is published by the render thread, so rotations sent before are saved too
+	while (m_commands.Size() > 0 || !m_rubikCube->IsIdle()) {
+		std::this_thread::yield();
+	}
+}
+
+void RubikCubeControl::PerformPendingCommands()
+{
+	while (auto command = m_commands.Front()) {
+		try {
+			switch (command->type) {
+			case CubeCommand::ROTATE:
+				if (!m_rubikCube->Rotate(static_cast<RubikCube::RotationType>(command->move.axis),
+					command->move.layer, command->move.clockwise)) {
+					if (!m_moveQueueFullReported) {
+						std::cout << "Move queue is full (" << m_rubikCube->GetNumPendingMoves() << " moves), "
+							<< m_commands.Size() << " commands wait\n";
+						m_moveQueueFullReported = true;
+					}
+					return;
+				}
+				m_moveQueueFullReported = false;
+				break;
+			case CubeCommand::REPLACE_CUBE:
+				*m_rubikCube = std::move(*command->cube);
+				break;
+			case CubeCommand::APPLY_MOVES:
+				m_rubikCube->ApplyMoves(*command->moves);
+				break;
+			case CubeCommand::SET_MAX_PENDING_MOVES:
+				m_rubikCube->SetMaxPendingMoves(command->maxPendingMoves);
+				break;
+			default:
+				break;
+			}
 		}
-		else {
-			std::cout << "Unknown command. Type help for available commands.\n";
+		catch (const std::exception& ex) {
+			std::cout << "Error: " << ex.what() << std::endl;
 		}
-	}
-	catch (const std::exception& ex) {
-		std::cout << "Error: " << ex.what() << std::endl;
+		m_commands.Pop();
 	}
 }
 
@@ -101,147 +276,85 @@ void RubikCubeControl::PrintHelp() const
 	std::cout << "quit - quit this program\n\n";
 	std::cout << "help - show this help\n\n";
 
-	std::cout << "rotate [face] [. (optional)] [level (optinal)] - rotate cube\n";
-	std::cout << "\t[face] F (Front), B (Back), U (Up), D (Down), L (Left), R (Right)\n";
-	std::cout << "\t3x3x3 Cube: \n";
-	std::cout << "\t\t[face] M (Middle layer, between Left and Right)\n";
-	std::cout << "\t\t[face] E (Equator layer, between Up and Down)\n";
-	std::cout << "\t\t[face] E (Standing layer, between Up and Down)\n";
+	std::cout << "rotate [moves] - rotate cube, moves are separated by spaces\n";
+	std::cout << "\t[face] F (Front), B (Back), U (Up), D (Down), L (Left), R (Right), clockwise as seen from the face\n";
+	std::cout << "\t[face]' or [face]. counter-clockwise, [face]2 half turn\n";
+	std::cout << "\tWide turns: Rw or r (two layers), 3Rw or 3r (three layers), 3R (third layer only), 2-4r (layers 2-4)\n";
+	std::cout << "\tM (as L), E (as D), S (as F) - all layers between the outer ones\n";
+	std::cout << "\tx (as R), y (as U), z (as F) - whole cube\n";
 	std::cout << "\tGeneric Cube: \n";
-	std::cout << "\t\t[face] X [level] X axis rotation on specific level (0-N)\n";
-	std::cout << "\t\t[face] Y [level] Y axis rotation on specific level (0-N)\n";
-	std::cout << "\t\t[face] Z [level] Z axis rotation on specific level (0-N)\n";
-	std::cout << "\tYou can write . symbol after each face to rotate counter-clockwise.\n";
-	std::cout << "\tThe default rotation direction is clockwise.\n";
+	std::cout << "\t\tX[level] X axis rotation on specific level (0-N), as L\n";
+	std::cout << "\t\tY[level] Y axis rotation on specific level (0-N), as D\n";
+	std::cout << "\t\tZ[level] Z axis rotation on specific level (0-N), as B\n";
+	std::cout << "\t\tX.[level] counter-clockwise\n";
+	std::cout << "\tOlder versions turned R, U, F and S as L, D and B and accepted X . 1, write X.1 now.\n";
+	std::cout << "\tRotations requested while the cube is rotating wait in a queue.\n";
 	std::cout << "\tExamples:\n";
-	std::cout << "\t\trotate F\n\t\trotate M .\n\t\trotate X . 1\n\n";
+	std::cout << "\t\trotate F\n\t\trotate R U R' U'\n\t\trotate 2-3Rw2 x'\n\t\trotate X.1\n\n";
 
-	std::cout << "undo - undo previous rotation\n\n";
+	std::cout << "queue_depth [num_moves] - maximum number of rotations waiting in the queue (0 disables the queue)\n\n";
+	std::cout << "undo - undo previous rotation (one layer quarter turn)\n\n";
+	std::cout << "redo - perform the last undone rotation again\n\n";
+	std::cout << "history_depth [num_moves] - number of rotations kept in memory for undo\n\n";
+	std::cout << "history_spill [filename | off] - keep older rotations in the file instead of forgetting them\n\n";
 	std::cout << "reset - reset current Rubik's Cube configuration\n\n";
 	std::cout << "new_cube [num_stickers] - create new Cube with specific number of stickers per edge\n\n";
-	std::cout << "save [filename] - save current Rubik's Cube configuration into file\n\n";
-	std::cout << "load [filename] - load Rubik's Cube configuration from file\n\n";
+	std::cout << "save [filename] - save current Rubik's Cube configuration into file once queued rotations are finished\n\n";
+	std::cout << "export [filename] - save current Rubik's Cube configuration into text file\n\n";
+	std::cout << "load [filename] - load Rubik's Cube configuration from saved or exported file\n\n";
 	std::cout << "save_rotations [filename] - save rotations history into file\n\n";
-	std::cout << "load_rotations [filename] - load rotations from file and perform them\n\n";
+	std::cout << "save_rotations_binary [filename] - save rotations history into compact binary file\n\n";
+	std::cout << "load_rotations [filename] - load rotations from text or binary file and perform them, they are added to the history\n";
+	std::cout << "\tText files start with the line " << RotationLogReader::NOTATION_HEADER
+		<< ", files saved by older versions have no such line and are read in their notation\n\n";
 }
 
-void RubikCubeControl::Rotate(const std::string& command, bool saveCommandToHistory)
+void RubikCubeControl::Rotate(const std::string& command)
 {
-	static auto check333CubeOrThrow = [this]() { 
-		if (m_rubikCube->GetNumStickersPerEdge() != 3) {
-			throw std::runtime_error("This operator is for 3x3x3 Rubik's Cube only");
-		}
-	};
-
-	auto commandWithoutSpaces = command;
-
-	// remove spaces and shrink the string
-	commandWithoutSpaces.erase(
-		std::remove_if(commandWithoutSpaces.begin(), commandWithoutSpaces.end(), ::isspace),
-		commandWithoutSpaces.end());
-	
-	char face = commandWithoutSpaces[0];
-	bool clockwise = commandWithoutSpaces[1] != '.';
-	bool needIndex = false;
-	unsigned int rotationIndex = 0;
-
-	if (face == 'X' || face == 'Y' || face == 'Z') {
-		needIndex = true;
-		auto pos = commandWithoutSpaces.find_first_of("0123456789");
-
-		if (pos != std::string::npos) {
-			rotationIndex = static_cast<unsigned int>(std::stol(commandWithoutSpaces.substr(pos)));
-		}
-		else {
-			throw std::runtime_error("Missing rotation level");
-		}
-	}
+	// The whole sequence is parsed first, so an invalid token rotates nothing
+	m_parsedMoves.clear();
+	CubeNotation::ParseSequence(command.data(), command.data() + command.size(), m_numStickersEdge, m_parsedMoves);
 
-	auto numStickers = m_rubikCube->GetNumStickersPerEdge();
-
-	switch (face) {
-	case 'F': // front
-		m_rubikCube->Rotate(RubikCube::Z_AXIS, numStickers - 1, clockwise);
-		break;
-	case 'B': // back
-		m_rubikCube->Rotate(RubikCube::Z_AXIS, 0, clockwise);
-		break;
-	case 'U': // up
-		m_rubikCube->Rotate(RubikCube::Y_AXIS, numStickers - 1, clockwise);
-		break;
-	case 'D': // down
-		m_rubikCube->Rotate(RubikCube::Y_AXIS, 0, clockwise);
-		break;
-	case 'L': // left
-		m_rubikCube->Rotate(RubikCube::X_AXIS, 0, clockwise);
-		break;
-	case 'R': // right
-		m_rubikCube->Rotate(RubikCube::X_AXIS, numStickers - 1, clockwise);
-		break;
-	case 'M': // x axis middle
-		check333CubeOrThrow();
-		m_rubikCube->Rotate(RubikCube::X_AXIS, 1, clockwise);
-		break;
-	case 'E': // y axis middle
-		check333CubeOrThrow();
-		m_rubikCube->Rotate(RubikCube::Y_AXIS, 1, clockwise);
-		break;
-	case 'S': // z axis middle
-		check333CubeOrThrow();
-		m_rubikCube->Rotate(RubikCube::Z_AXIS, 1, clockwise);
-		break;
-	case 'X':
-		m_rubikCube->Rotate(RubikCube::X_AXIS, rotationIndex, clockwise);
-		break;
-	case 'Y':
-		m_rubikCube->Rotate(RubikCube::Y_AXIS, rotationIndex, clockwise);
-		break;
-	case 'Z':
-		m_rubikCube->Rotate(RubikCube::Z_AXIS, rotationIndex, clockwise);
-		break;
-	default:
-		throw std::runtime_error("Unknown face");
-		break;
-	}
-
-	if (saveCommandToHistory) {
-		std::stringstream ss;
-		ss << face;
-
-		if (!clockwise) {
-			ss << '.';
-		}
-		if (needIndex) {
-			ss << rotationIndex;
-		}
+	SendRotations(m_parsedMoves);
 
-		m_rotationHistory.push_back(ss.str());
+	for (auto& move : m_parsedMoves) {
+		m_history.Push(move);
 	}
 }
 
 void RubikCubeControl::UndoRotation()
 {
-	if (m_rotationHistory.empty()) {
+	MoveTable::Move inverse;
+
+	if (!m_history.Undo(inverse)) {
 		throw std::runtime_error("Rotation history is empty");
 	}
+	SendRotations({ inverse });
+}
+
+void RubikCubeControl::RedoRotation()
+{
+	MoveTable::Move move;
 
-	const auto& lastCommand = m_rotationHistory.back();
-	std::stringstream ss;
+	if (!m_history.Redo(move)) {
+		throw std::runtime_error("There is no undone rotation");
+	}
+	SendRotations({ move });
+}
 
-	if (auto pos = lastCommand.find_first_of('.') != std::string::npos) {
-		// rotation was counter-clockwise
-		ss << lastCommand[0] << lastCommand.c_str() + pos + 1;
+void RubikCubeControl::SetHistorySpillFile(const std::string& filename)
+{
+	if (filename == "off") {
+		m_history.SetSpillFile(std::string());
+		std::cout << "Older rotations are forgotten\n";
 	}
 	else {
-		// clockwise rotation
-		ss << lastCommand[0] << '.' << lastCommand.c_str() + 1;
+		m_history.SetSpillFile(filename);
+		std::cout << "Older rotations are kept in " << filename << "\n";
 	}
-
-	Rotate(ss.str(), false);
-	m_rotationHistory.pop_back();
 }
 
-void RubikCubeControl::SaveRotations(const std::string& filename) const
+void RubikCubeControl::SaveRotations(const std::string& filename)
 {
 	std::fstream file(filename, std::fstream::out);
 
@@ -249,31 +362,86 @@ void RubikCubeControl::SaveRotations(const std::string& filename) const
 		throw std::runtime_error("Unable to create file for saving");
 	}
 
-	for (const auto& rotationCommand : m_rotationHistory) {
-		file << rotationCommand << std::endl;
-	}
+	// Generic notation, every move is written as its axis, direction and layer
+	file << RotationLogReader::NOTATION_HEADER << '\n';
+
+	m_history.ForEachMove([&file](const MoveTable::Move& move) {
+		file << static_cast<char>('X' + move.axis) << (move.clockwise ? "" : ".") << move.layer << '\n';
+	});
 
 	file.close();
 }
 
+void RubikCubeControl::SaveRotationsBinary(const std::string& filename)
+{
+	MoveLogWriter writer(filename, m_numStickersEdge);
+
+	m_history.ForEachMove([&writer](const MoveTable::Move& move) {
+		writer.Write(move);
+	});
+
+	writer.Close();
+}
+
 void RubikCubeControl::LoadAndPerformRotations(const std::string& filename)
 {
-	std::fstream file(filename, std::fstream::in);
+	if (MoveLogReader::IsMoveLog(filename)) {
+		MoveLogReader reader(filename);
 
-	if (!file.good()) {
-		throw std::runtime_error("Unable to open savefile");
+		if (reader.NumStickersEdge() != m_numStickersEdge) {
+			throw std::runtime_error("Move log was recorded for another cube's level");
+		}
+		PerformRotations(reader);
 	}
+	else {
+		RotationLogReader reader(filename, m_numStickersEdge);
 
-	while (!file.eof()) {
-		std::string rotationCommand;
-		file >> rotationCommand;
+		if (reader.IsLegacy()) {
+			std::cout << "Rotation log has no \"" << RotationLogReader::NOTATION_HEADER
+				<< "\" header, it is read in the notation of older versions (R U F S turn as L D B)\n";
+		}
+		PerformRotations(reader);
+	}
+}
+
+template <typename Reader>
+void RubikCubeControl::PerformRotations(Reader& reader)
+{
+	auto startTime = std::chrono::steady_clock::now();
+	size_t numMoves = 0;
+
+	// The render thread performs every batch at once without animation
+	for (;;) {
+		auto moves = std::make_shared<std::vector<MoveTable::Move>>();
+		moves->reserve(MOVE_BATCH_SIZE);
+
+		if (!reader.ReadMoves(*moves, MOVE_BATCH_SIZE)) {
+			break;
+		}
+		numMoves += moves->size();
 
-		if (!rotationCommand.empty()) {
-			Rotate(rotationCommand);
-			// "hack" - update the cube to finish the rotation animation immediately
-			m_rubikCube->Update(1000.f);
+		// Loaded moves are undone and saved like typed ones, the spill file keeps memory bounded
+		for (auto& move : *moves) {
+			m_history.Push(move);
 		}
+
+		// Only a few batches are in flight, so memory does not grow with the file
+		while (m_commands.Size() >= MAX_BATCHES_IN_FLIGHT) {
+			std::this_thread::yield();
+		}
+		Send(CubeCommand::ApplyMoves(moves));
 	}
 
-	file.close();
+	// Throughput includes performing the last batch
+	while (m_commands.Size() > 0) {
+		std::this_thread::yield();
+	}
+
+	m_statistics.AddMoves(numMoves);
+
+	auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+	auto megabytes = reader.BytesRead() / (1024. * 1024.);
+
+	std::cout << numMoves << " rotations, " << megabytes << " MB in " << seconds << " s ("
+		<< megabytes / std::max(seconds, 1e-9) << " MB/s)\n";
 }
\ No newline at end of file
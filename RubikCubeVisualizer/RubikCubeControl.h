@@ -1,34 +1,107 @@
 #ifndef RUBIK_CUBE_CONTROL_H
 #define RUBIK_CUBE_CONTROL_H
 
+#include "CommandStatistics.h"
+#include "CubeCommand.h"
+#include "MoveHistory.h"
 #include "RubikCube.h"
+#include "SpscRing.h"
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <istream>
 #include <memory>
+#include <string>
 #include <thread>
-#include <list>
+#include <vector>
 
 // Rubik's cube control center
-// It runs in separate thread
+// It runs in separate thread, commands are sent to the render thread through a lock-free ring,
+// so the control thread never touches the cube being drawn
+// Commands are typed by the user or read from a script, which reports the latency of every command at its end
 class RubikCubeControl final {
 private:
 
+	static constexpr size_t COMMAND_RING_SIZE = 1024u;
+
+	// Rotation logs are streamed to the render thread in batches of this many moves
+	static constexpr size_t MOVE_BATCH_SIZE = 1u << 16;
+	static constexpr size_t MAX_BATCHES_IN_FLIGHT = 4u;
+
 	std::shared_ptr<RubikCube> m_rubikCube;
+	SpscRing<CubeCommand, COMMAND_RING_SIZE> m_commands;
+
+	// Cube's level after all sent commands are performed
+	unsigned int m_numStickersEdge;
 	std::thread m_thread;
-	bool m_running;
-	std::list<std::string> m_rotationHistory;
+	std::atomic<bool> m_running;
+
+	// Without rendering commands are performed right away and rotations are not animated
+	bool m_headless;
+
+	// Commands are read from the script if it is open, from the standard input otherwise
+	std::ifstream m_script;
+	std::istream* m_input;
+
+	CommandStatistics m_statistics;
+	std::chrono::steady_clock::time_point m_startTime;
+
+	// Render thread only, the full move queue is reported once until it accepts a move again
+	bool m_moveQueueFullReported;
+
+	// Rotations performed by rotate, undo and redo walk it without parsing
+	MoveHistory m_history;
+
+	// Moves of the last rotate command, kept to reuse its memory
+	std::vector<MoveTable::Move> m_parsedMoves;
 
-	void HandleCommand();
+	// Read and perform one command, false once there are no more commands
+	bool HandleCommand();
+	void PerformCommand(const std::string& command);
+
+	// Wait until there is a free slot in the ring, without rendering the command is performed right away
+	void Send(CubeCommand&& command);
+
+	// Rotations are animated one by one, without rendering they are applied at once
+	void SendRotations(const std::vector<MoveTable::Move>& moves);
+
+	// Wait until the render thread performed all sent commands and the cube finished all rotations
+	void WaitUntilPerformed();
 	void PrintHelp() const;
-	void Rotate(const std::string& command, bool saveCommandToHistory = true);
+
+	// Rotate by all moves of the sequence in CubeNotation
+	void Rotate(const std::string& command);
 	void UndoRotation();
-	void SaveRotations(const std::string& filename) const;
+	void RedoRotation();
+	void SetHistorySpillFile(const std::string& filename);
+	void SaveRotations(const std::string& filename);
+
+	// Binary move log, see MoveLogFormat
+	void SaveRotationsBinary(const std::string& filename);
+
+	// Text rotation log or binary move log, the format is detected from the file
 	void LoadAndPerformRotations(const std::string& filename);
 
+	// Stream all moves of the reader to the render thread in batches and report the throughput
+	template <typename Reader>
+	void PerformRotations(Reader& reader);
+
 public:
 
-	RubikCubeControl(const std::shared_ptr<RubikCube>& rubikCube);
+	// Commands are read from the standard input if there is no script
+	// The control runs in its own thread unless it is headless, then Run must be called
+	RubikCubeControl(const std::shared_ptr<RubikCube>& rubikCube, const std::string& scriptPath = std::string(),
+		bool headless = false);
 	~RubikCubeControl();
 
+	// Handle commands until quit or the end of the script
+	void Run();
+
 	bool IsRunning() const { return m_running; }
+
+	// Perform commands sent by the control thread, call it from the render thread only
+	// A rotation waits in the ring while the cube's queue of pending moves is full
+	void PerformPendingCommands();
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,257 @@
+#include "RubikCubeRenderer.h"
+#include <glm/gtx/transform.hpp>
+#include <stdexcept>
+
+RubikCubeRenderer::RubikCubeRenderer(GLint positionShaderAttribute, GLint normalShaderAttribute)
+{
+	m_unitCube = std::make_unique<UnitCube>(positionShaderAttribute, normalShaderAttribute);
+	m_sticker = std::make_unique<Sticker>(positionShaderAttribute, normalShaderAttribute);
+}
+
+void RubikCubeRenderer::DrawFace(const RubikCube::Snapshot& cube,
+	RubikCube::FaceIndex face,
+	const glm::mat4& rotationMatrix,
+	unsigned int startX, unsigned int startY,
+	unsigned int endX, unsigned int endY,
+	const Camera& camera,
+	const MatrixShaderUniforms& matrixUniforms,
+	const MaterialShaderUniforms& materialUniforms) const
+{
+	auto numStickers = cube.GetNumStickersPerEdge();
+	
+	if (startX < 0 || startY < 0) {
+		throw std::runtime_error("DrawFace: start coordinates cannot be negative");
+	}
+	if (endX > numStickers || endY > numStickers) {
+		throw std::runtime_error("DrawFace: end coordinates cannot be larger than cube proportions");
+	}
+	if (startX >= endX || startY >= endY) {
+		return; // no throw
+	}
+
+	auto pi = glm::pi<float>();
+	glm::mat4 rotationMat;
+
+	switch (face) {
+	case RubikCube::TOP:
+		// Sticker's default face is top
+		break;
+	case RubikCube::BOTTOM:
+		rotationMat = glm::rotate(pi, glm::vec3(1.f, 0.f, 0.f));
+		break;
+	case RubikCube::LEFT:
+		rotationMat = glm::rotate(pi / 2.f, glm::vec3(0.f, 0.f, 1.f));
+		break;
+	case RubikCube::RIGHT:
+		rotationMat = glm::rotate(-pi / 2.f, glm::vec3(0.f, 0.f, 1.f));
+		break;
+	case RubikCube::FRONT:
+		rotationMat = glm::rotate(pi / 2.f, glm::vec3(1.f, 0.f, 0.f));
+		break;
+	case RubikCube::BACK:
+		rotationMat = glm::rotate(-pi / 2.f, glm::vec3(1.f, 0.f, 0.f));
+		break;
+	}
+
+	auto stickerSize = GetStickerSize(cube);
+	bool mergeRuns = numStickers > MAX_SEPARATED_STICKERS_PER_LINE;
+	
+	// Equal rows are drawn at once, sparse gigantic cubes are only a few rectangles per face
+	for (auto x = startX; x < endX;) {
+		auto rows = mergeRuns ? cube.GetEqualRows(face, x, endX) : 1u;
+		auto numRows = static_cast<float>(rows);
+
+		for (auto y = startY; y < endY;) {
+			auto color = cube.GetSticker(face, x, y);
+			auto runEnd = mergeRuns ? y + cube.GetStickerRunLength(face, x, y, endY) : y + 1;
+			auto runLength = static_cast<float>(runEnd - y);
+			auto& surfaceMaterial = Sticker::GetStickerMaterial(color);
+
+			float translateX = -stickerSize * numStickers / 2.f + numRows * stickerSize / 2.f + x * stickerSize;
+			float translateZ = -stickerSize * numStickers / 2.f + runLength * stickerSize / 2.f + y * stickerSize;
+
+			auto translationMat = glm::translate(glm::vec3(translateX, 0.001f, translateZ));
+			auto scaleMat = glm::scale(glm::vec3(stickerSize*(numRows - 0.1f), 1.f, stickerSize*(runLength - 0.1f)));
+			auto finalTransform = rotationMatrix * rotationMat * translationMat * scaleMat;
+
+			m_sticker->Draw(camera, finalTransform, surfaceMaterial, matrixUniforms, materialUniforms);
+			y = runEnd;
+		}
+		x += rows;
+	}
+}
+
+void RubikCubeRenderer::DrawCubeNoRotation(const RubikCube::Snapshot& cube,
+	const Camera& camera,
+	const MatrixShaderUniforms& matrixUniforms,
+	const MaterialShaderUniforms& materialUniforms) const
+{
+	m_unitCube->Draw(camera, matrixUniforms, materialUniforms);
+
+	auto numStickers = cube.GetNumStickersPerEdge();
+
+	for (auto face = 0u; face < StickerBuffer::NUM_FACES; face++) {
+		DrawFace(cube, static_cast<RubikCube::FaceIndex>(face), glm::mat4(1.f), 0, 0,
+			numStickers, numStickers, camera, matrixUniforms, materialUniforms);
+	}
+}
+
+void RubikCubeRenderer::DrawCubeXAxisRotation(const RubikCube::Snapshot& cube,
+	const Camera& camera,
+	const MatrixShaderUniforms& matrixUniforms,
+	const MaterialShaderUniforms& materialUniforms) const
+{
+	auto numStickers = cube.GetNumStickersPerEdge();
+	auto rotation = cube.GetRotation();
+	glm::vec3 rotationVec(1.f, 0.f, 0.f);
+	glm::mat4 identityMat(1.f);
+	auto rotationMat = glm::rotate(GetRotationAngle(rotation), rotationVec);
+
+	DrawUnitCubeGenericRotation(cube, camera, rotationVec, matrixUniforms, materialUniforms);
+
+	DrawFace(cube, RubikCube::LEFT, rotation.index == 0 ? rotationMat : identityMat, 0, 0,
+		numStickers, numStickers, camera, matrixUniforms, materialUniforms);
+	
+	DrawFace(cube, RubikCube::RIGHT, (rotation.index == numStickers - 1) ? rotationMat : identityMat, 0, 0,
+		numStickers, numStickers, camera, matrixUniforms, materialUniforms);
+	
+	for (auto face : { RubikCube::TOP, RubikCube::BACK, RubikCube::FRONT, RubikCube::BOTTOM }) {
+		auto i = rotation.index;
+		DrawFace(cube, face, rotationMat, i, 0, i + 1, numStickers, camera, matrixUniforms, materialUniforms);
+		DrawFace(cube, face, identityMat, 0, 0, i, numStickers, camera, matrixUniforms, materialUniforms);
+		DrawFace(cube, face, identityMat, i + 1, 0, numStickers, numStickers, camera, matrixUniforms, materialUniforms);
+	}
+}
+
+void RubikCubeRenderer::DrawCubeYAxisRotation(const RubikCube::Snapshot& cube,
+	const Camera& camera,
+	const MatrixShaderUniforms& matrixUniforms,
+	const MaterialShaderUniforms& materialUniforms) const
+{
+	auto numStickers = cube.GetNumStickersPerEdge();
+	auto rotation = cube.GetRotation();
+	glm::vec3 rotationVec(0.f, 1.f, 0.f);
+	glm::mat4 identityMat(1.f);
+	auto rotationMat = glm::rotate(GetRotationAngle(rotation), rotationVec);
+
+	DrawUnitCubeGenericRotation(cube, camera, rotationVec, matrixUniforms, materialUniforms);
+
+	DrawFace(cube, RubikCube::BOTTOM, rotation.index == 0 ? rotationMat : identityMat, 0, 0,
+		numStickers, numStickers, camera, matrixUniforms, materialUniforms);
+
+	DrawFace(cube, RubikCube::TOP, (rotation.index == numStickers - 1) ? rotationMat : identityMat, 0, 0,
+		numStickers, numStickers, camera, matrixUniforms, materialUniforms);
+
+	// Unlike in rotation around X axis, [0, 0] points of faces aren't in straight line there
+	for (auto face : { RubikCube::FRONT, RubikCube::RIGHT, RubikCube::BACK, RubikCube::LEFT }) {
+		auto i = (face == RubikCube::FRONT || face == RubikCube::RIGHT) ? numStickers - rotation.index - 1 : rotation.index;
+
+		if (face == RubikCube::FRONT || face == RubikCube::BACK) {
+			DrawFace(cube, face, rotationMat, 0, i, numStickers, i + 1, camera, matrixUniforms, materialUniforms);
+			DrawFace(cube, face, identityMat, 0, 0, numStickers, i, camera, matrixUniforms, materialUniforms);
+			DrawFace(cube, face, identityMat, 0, i + 1, numStickers, numStickers, camera, matrixUniforms, materialUniforms);
+		}
+		else {
+			DrawFace(cube, face, rotationMat, i, 0, i + 1, numStickers, camera, matrixUniforms, materialUniforms);
+			DrawFace(cube, face, identityMat, 0, 0, i, numStickers, camera, matrixUniforms, materialUniforms);
+			DrawFace(cube, face, identityMat, i + 1, 0, numStickers, numStickers, camera, matrixUniforms, materialUniforms);
+		}
+	}
+}
+
+void RubikCubeRenderer::DrawCubeZAxisRotation(const RubikCube::Snapshot& cube,
+	const Camera& camera,
+	const MatrixShaderUniforms& matrixUniforms,
+	const MaterialShaderUniforms& materialUniforms) const
+{
+	auto numStickers = cube.GetNumStickersPerEdge();
+	auto rotation = cube.GetRotation();
+	glm::vec3 rotationVec(0.f, 0.f, 1.f);
+	glm::mat4 identityMat(1.f);
+	auto&& rotationMat = glm::rotate(GetRotationAngle(rotation), rotationVec);
+
+	DrawUnitCubeGenericRotation(cube, camera, rotationVec, matrixUniforms, materialUniforms);
+
+	DrawFace(cube, RubikCube::BACK, rotation.index == 0 ? rotationMat : identityMat, 0, 0,
+		numStickers, numStickers, camera, matrixUniforms, materialUniforms);
+
+	DrawFace(cube, RubikCube::FRONT, (rotation.index == numStickers - 1) ? rotationMat : identityMat, 0, 0,
+		numStickers, numStickers, camera, matrixUniforms, materialUniforms);
+
+	for (auto face : { RubikCube::TOP, RubikCube::RIGHT, RubikCube::LEFT, RubikCube::BOTTOM }) {
+		auto i = (face == RubikCube::BOTTOM) ? numStickers - rotation.index - 1 : rotation.index;
+
+		DrawFace(cube, face, rotationMat, 0, i, numStickers, i + 1, camera, matrixUniforms, materialUniforms);
+		DrawFace(cube, face, identityMat, 0, 0, numStickers, i, camera, matrixUniforms, materialUniforms);
+		DrawFace(cube, face, identityMat, 0, i + 1, numStickers, numStickers, camera, matrixUniforms, materialUniforms);
+	}
+}
+
+void RubikCubeRenderer::DrawUnitCubeGenericRotation(const RubikCube::Snapshot& cube,
+	const Camera& camera,
+	const glm::vec3& transformationVec,
+	const MatrixShaderUniforms& matrixUniforms,
+	const MaterialShaderUniforms& materialUniforms) const
+{
+	// Apply this function after transformationVec multiplication!
+	// We have no other option than pass zeros on specific axes where we don't wanna apply scaling
+	// and then reset these zeros back to one
+	static auto resetZerosScale = [](glm::vec3& scale) -> auto& {
+		scale.x = scale.x == 0.f ? 1.f : scale.x;
+		scale.y = scale.y == 0.f ? 1.f : scale.y;
+		scale.z = scale.z == 0.f ? 1.f : scale.z;
+		return scale;
+	};
+
+	auto numStickers = cube.GetNumStickersPerEdge();
+	auto rotation = cube.GetRotation();
+	auto stickerSize = GetStickerSize(cube);
+	auto cubeSize = m_unitCube->CubeSize();
+
+	// Rotating part
+	m_unitCube->Translate(transformationVec * (stickerSize / 2.f - cubeSize / 2.f + rotation.index * stickerSize));
+	m_unitCube->Rotate(GetRotationAngle(rotation), transformationVec);
+	m_unitCube->Scale(resetZerosScale(transformationVec * stickerSize));
+	m_unitCube->Draw(camera, matrixUniforms, materialUniforms);
+	m_unitCube->ResetTransformations();
+
+	// Static "left" side
+	if (rotation.index > 0) {
+		m_unitCube->Translate(transformationVec * (rotation.index * stickerSize / 2.f - cubeSize / 2.f));
+		m_unitCube->Scale(resetZerosScale(transformationVec * (rotation.index * stickerSize)));
+		m_unitCube->Draw(camera, matrixUniforms, materialUniforms);
+		m_unitCube->ResetTransformations();
+	}
+
+	// Static "right" side
+	if (rotation.index < numStickers - 1) {
+		m_unitCube->Translate(transformationVec * (cubeSize / 2.f - (numStickers - rotation.index - 1) * stickerSize / 2.f));
+		m_unitCube->Scale(resetZerosScale(transformationVec * ((numStickers - rotation.index - 1) * stickerSize)));
+		m_unitCube->Draw(camera, matrixUniforms, materialUniforms);
+		m_unitCube->ResetTransformations();
+	}
+}
+
+void RubikCubeRenderer::Draw(const RubikCube& cube,
+	const Camera& camera,
+	const MatrixShaderUniforms& matrixUniforms,
+	const MaterialShaderUniforms& materialUniforms) const
+{
+	// The snapshot stays valid for the whole frame, no matter what happens to the cube meanwhile
+	auto snapshot = cube.GetSnapshot();
+
+	switch (snapshot->GetRotation().type) {
+	case RubikCube::NONE:
+		DrawCubeNoRotation(*snapshot, camera, matrixUniforms, materialUniforms);
+		break;
+	case RubikCube::X_AXIS:
+		DrawCubeXAxisRotation(*snapshot, camera, matrixUniforms, materialUniforms);
+		break;
+	case RubikCube::Y_AXIS:
+		DrawCubeYAxisRotation(*snapshot, camera, matrixUniforms, materialUniforms);
+		break;
+	case RubikCube::Z_AXIS:
+		DrawCubeZAxisRotation(*snapshot, camera, matrixUniforms, materialUniforms);
+		break;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,75 @@
+#ifndef RUBIK_CUBE_RENDERER_H
+#define RUBIK_CUBE_RENDERER_H
+
+#include "RubikCube.h"
+#include "UnitCube.h"
+#include "Sticker.h"
+#include <memory>
+
+// Draws RubikCube model together with its rotation animation
+// Owns GPU meshes, so it needs GL context unlike the cube itself
+// It draws the cube's latest snapshot, so the cube is never locked during the frame
+class RubikCubeRenderer final {
+private:
+
+	// Bigger cubes draw a run of stickers with the same color in one row as a single quad
+	static constexpr unsigned int MAX_SEPARATED_STICKERS_PER_LINE = 15u;
+
+	std::unique_ptr<UnitCube> m_unitCube;
+	std::unique_ptr<Sticker> m_sticker;
+
+	static float GetRotationAngle(const RubikCube::Rotation& rotation)
+		{ return rotation.progress * glm::half_pi<float>() * ((rotation.clockwise) ? 1.f : -1.f); }
+
+	float GetStickerSize(const RubikCube::Snapshot& cube) const
+		{ return m_unitCube->CubeSize() / (cube.GetNumStickersPerEdge() * m_sticker->StickerSize()); }
+
+	void DrawFace(const RubikCube::Snapshot& cube,
+		RubikCube::FaceIndex face,
+		const glm::mat4& rotationMatrix,
+		unsigned int startX, unsigned int startY,
+		unsigned int endX, unsigned int endY,
+		const Camera& camera,
+		const MatrixShaderUniforms& matrixUniforms,
+		const MaterialShaderUniforms& materialUniforms) const;
+
+	void DrawCubeNoRotation(const RubikCube::Snapshot& cube,
+		const Camera& camera,
+		const MatrixShaderUniforms& matrixUniforms,
+		const MaterialShaderUniforms& materialUniforms) const;
+
+	void DrawCubeXAxisRotation(const RubikCube::Snapshot& cube,
+		const Camera& camera,
+		const MatrixShaderUniforms& matrixUniforms,
+		const MaterialShaderUniforms& materialUniforms) const;
+
+	void DrawCubeYAxisRotation(const RubikCube::Snapshot& cube,
+		const Camera& camera,
+		const MatrixShaderUniforms& matrixUniforms,
+		const MaterialShaderUniforms& materialUniforms) const;
+
+	void DrawCubeZAxisRotation(const RubikCube::Snapshot& cube,
+		const Camera& camera,
+		const MatrixShaderUniforms& matrixUniforms,
+		const MaterialShaderUniforms& materialUniforms) const;
+
+	void DrawUnitCubeGenericRotation(const RubikCube::Snapshot& cube,
+		const Camera& camera,
+		const glm::vec3& transformationVec,
+		const MatrixShaderUniforms& matrixUniforms,
+		const MaterialShaderUniforms& materialUniforms) const;
+
+public:
+
+	RubikCubeRenderer(GLint positionShaderAttribute, GLint normalShaderAttribute);
+
+	RubikCubeRenderer(const RubikCubeRenderer&) = delete;
+	RubikCubeRenderer& operator=(const RubikCubeRenderer&) = delete;
+
+	void Draw(const RubikCube& cube,
+		const Camera& camera,
+		const MatrixShaderUniforms& matrixUniforms,
+		const MaterialShaderUniforms& materialUniforms) const;
+};
+
+#endif
\ No newline at end of file
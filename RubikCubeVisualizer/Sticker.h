@@ -7,20 +7,14 @@
 #include "MaterialShaderUniforms.h"
 #include "MatrixShaderUniforms.h"
 #include "SurfaceMaterial.h"
+#include "StickerColor.h"
 #include "Camera.h"
 
 // Generic top-faced sticker used as surface on rubik cube
 class Sticker final {
 public:
 
-	enum Color {
-		WHITE = 0,
-		RED,
-		BLUE,
-		ORANGE,
-		GREEN,
-		YELLOW
-	};
+	typedef StickerColor::Color Color;
 
 	static const SurfaceMaterial& GetStickerMaterial(Color color);
 